@@ -32,6 +32,22 @@ class B
 B<A> g_b;
 '''
 
+THREAD_LOCAL = '''
+struct A
+{
+  A() : value(0) {}
+  int value;
+};
+
+thread_local A g_a;
+
+int
+f()
+{
+  return g_a.value;
+}
+'''
+
 @conf
 def check_friend_typename(self):
     if self.check_cxx(msg='Checking for friend typename-specifier',
@@ -43,5 +59,13 @@ def check_friend_typename(self):
                       features='cxx', mandatory=True):
         self.define('HAVE_CXX_FRIEND_TYPENAME_WRAPPER', 1)
 
+@conf
+def check_thread_local(self):
+    if self.check_cxx(msg='Checking for thread_local',
+                      fragment=THREAD_LOCAL,
+                      features='cxx', mandatory=False):
+        self.define('HAVE_CXX_THREAD_LOCAL', 1)
+
 def configure(conf):
     conf.check_friend_typename()
+    conf.check_thread_local()
@@ -20,7 +20,9 @@
  */
 
 #include "data.hpp"
+#include "detail/wire-check.hpp"
 #include "encoding/block-helpers.hpp"
+#include "encoding/buffer-stream.hpp"
 #include "util/crypto.hpp"
 #include "util/concepts.hpp"
 
@@ -34,15 +36,21 @@ static_assert(std::is_base_of<tlv::Error, Data::Error>::value,
 
 Data::Data()
   : m_content(tlv::Content) // empty content
+  , m_lazyFields(0)
+  , m_hasContentRoom(false)
 {
 }
 
 Data::Data(const Name& name)
   : m_name(name)
+  , m_lazyFields(0)
+  , m_hasContentRoom(false)
 {
 }
 
 Data::Data(const Block& wire)
+  : m_lazyFields(0)
+  , m_hasContentRoom(false)
 {
   wireDecode(wire);
 }
@@ -61,7 +69,8 @@ Data::wireEncode(EncodingImpl<T>& block, bool unsignedPortion/* = false*/) const
 
   // (reverse encoding)
 
-  if (!unsignedPortion && !m_signature)
+  const Signature& signature = getSignature();
+  if (!unsignedPortion && !signature)
     {
       throw Error("Requested wire format, but data packet has not been signed yet");
     }
@@ -69,11 +78,11 @@ Data::wireEncode(EncodingImpl<T>& block, bool unsignedPortion/* = false*/) const
   if (!unsignedPortion)
     {
       // SignatureValue
-      totalLength += prependBlock(block, m_signature.getValue());
+      totalLength += prependBlock(block, signature.getValue());
     }
 
   // SignatureInfo
-  totalLength += prependBlock(block, m_signature.getInfo());
+  totalLength += prependBlock(block, signature.getInfo());
 
   // Content
   totalLength += prependBlock(block, getContent());
@@ -109,23 +118,59 @@ Data::wireEncode(EncodingBuffer& encoder, const Block& signatureValue) const
   totalLength += encoder.prependVarNumber(totalLength);
   encoder.prependVarNumber(tlv::Data);
 
-  const_cast<Data*>(this)->wireDecode(encoder.block());
+  // Name, MetaInfo, and Content were just encoded from their current values, so only the
+  // top-level elements are located; Signature is taken from the wire on first access
+  m_wire = encoder.block();
+  m_wire.parse();
+  m_fullName.clear();
+  m_lazyFields = LAZY_SIGNATURE;
   return m_wire;
 }
 
+bool
+Data::wireEncodeAroundContent(EncodingBuffer& encoder) const
+{
+  // the buffer is shared only by m_content and the returned pointer, so nothing else can
+  // see the bytes around the content being overwritten
+  if (!m_hasContentRoom || m_content.getBuffer().use_count() != 2)
+    return false;
+
+  EncodingBuffer contentEncoder(m_content);
+
+  // Content (in place)
+  // MetaInfo
+  getMetaInfo().wireEncode(contentEncoder);
+  // Name
+  getName().wireEncode(contentEncoder);
+  // SignatureInfo
+  contentEncoder.appendBlock(getSignature().getInfo());
+
+  encoder = contentEncoder;
+  return true;
+}
+
 const Block&
 Data::wireEncode() const
 {
   if (m_wire.hasWire())
     return m_wire;
 
-  EncodingEstimator estimator;
-  size_t estimatedSize = wireEncode(estimator);
+  EncodingBuffer contentEncoder(0, 0);
+  if (getSignature() && wireEncodeAroundContent(contentEncoder))
+    return wireEncode(contentEncoder, getSignature().getValue());
 
-  EncodingBuffer buffer(estimatedSize, 0);
+#ifdef NDN_CXX_HAVE_CXX_THREAD_LOCAL
+  EncodingBuffer buffer(encoding::Pooled);
+#else
+  // without a slab pool, size the buffer exactly
+  EncodingEstimator estimator;
+  EncodingBuffer buffer(wireEncode(estimator), 0);
+#endif // NDN_CXX_HAVE_CXX_THREAD_LOCAL
   wireEncode(buffer);
 
   const_cast<Data*>(this)->wireDecode(buffer.block());
+  // the other fields were just encoded from their current values
+  m_lazyFields = LAZY_SIGNATURE;
   return m_wire;
 }
 
@@ -135,6 +180,7 @@ Data::wireDecode(const Block& wire)
   m_fullName.clear();
   m_wire = wire;
   m_wire.parse();
+  m_hasContentRoom = false;
 
   // Data ::= DATA-TLV TLV-LENGTH
   //            Name
@@ -142,26 +188,47 @@ Data::wireDecode(const Block& wire)
   //            Content
   //            Signature
 
-  // Name
-  m_name.wireDecode(m_wire.get(tlv::Name));
-
-  // MetaInfo
-  m_metaInfo.wireDecode(m_wire.get(tlv::MetaInfo));
+  // Name, MetaInfo, and Signature are checked here but materialized on first access, so
+  // that packets that are merely relayed or cached are not decoded deeply.
+  wire_check::checkName(m_wire.get(tlv::Name));
+  wire_check::checkMetaInfo(m_wire.get(tlv::MetaInfo));
+  wire_check::checkSignatureInfo(m_wire.get(tlv::SignatureInfo));
 
   // Content
   m_content = m_wire.get(tlv::Content);
 
-  ///////////////
-  // Signature //
-  ///////////////
+  m_lazyFields = LAZY_NAME | LAZY_META_INFO | LAZY_SIGNATURE;
+}
 
-  // SignatureInfo
-  m_signature.setInfo(m_wire.get(tlv::SignatureInfo));
+void
+Data::decodeLazyFields(int fields) const
+{
+  fields &= m_lazyFields;
+
+  if (fields & LAZY_NAME) {
+    m_name.wireDecode(m_wire.get(tlv::Name));
+    m_lazyFields &= ~LAZY_NAME;
+  }
 
-  // SignatureValue
-  Block::element_const_iterator val = m_wire.find(tlv::SignatureValue);
-  if (val != m_wire.elements_end())
-    m_signature.setValue(*val);
+  if (fields & LAZY_META_INFO) {
+    m_metaInfo.wireDecode(m_wire.get(tlv::MetaInfo));
+    m_lazyFields &= ~LAZY_META_INFO;
+  }
+
+  if (fields & LAZY_SIGNATURE) {
+    Signature signature;
+
+    // SignatureInfo
+    signature.setInfo(m_wire.get(tlv::SignatureInfo));
+
+    // SignatureValue
+    Block::element_const_iterator val = m_wire.find(tlv::SignatureValue);
+    if (val != m_wire.elements_end())
+      signature.setValue(*val);
+
+    m_signature = signature;
+    m_lazyFields &= ~LAZY_SIGNATURE;
+  }
 }
 
 Data&
@@ -181,13 +248,35 @@ Data::getFullName() const
       throw Error("Full name requested, but Data packet does not have wire format "
                   "(e.g., not signed)");
     }
-    m_fullName = m_name;
+    m_fullName = getName();
     m_fullName.appendImplicitSha256Digest(crypto::sha256(m_wire.wire(), m_wire.size()));
   }
 
   return m_fullName;
 }
 
+shared_ptr<Data>
+Data::makeCompactCopy() const
+{
+  if (!m_wire.hasWire()) {
+    throw Error("Compact copy requested, but Data packet does not have wire format");
+  }
+
+  shared_ptr<Data> copy = make_shared<Data>(Block(m_wire.wire(), m_wire.size()));
+  // fields already decoded here are decoded in the copy as well
+  copy->decodeLazyFields((LAZY_NAME | LAZY_META_INFO | LAZY_SIGNATURE) & ~m_lazyFields);
+  if (!m_fullName.empty()) {
+    // the digest is copied, so that the copy holds no reference into the original buffer
+    const name::Component& digest = m_fullName.get(-1);
+    copy->m_fullName = copy->getName();
+    copy->m_fullName.appendImplicitSha256Digest(digest.value(), digest.value_size());
+  }
+  static_cast<TagHost&>(*copy) = *this;
+  copy->m_localControlHeader = m_localControlHeader;
+
+  return copy;
+}
+
 Data&
 Data::setMetaInfo(const MetaInfo& metaInfo)
 {
@@ -241,6 +330,7 @@ Data::setContent(const uint8_t* content, size_t contentLength)
   onChanged();
 
   m_content = dataBlock(tlv::Content, content, contentLength);
+  m_hasContentRoom = false;
 
   return *this;
 }
@@ -251,6 +341,7 @@ Data::setContent(const ConstBufferPtr& contentValue)
   onChanged();
 
   m_content = Block(tlv::Content, contentValue); // not a real wire encoding yet
+  m_hasContentRoom = false;
 
   return *this;
 }
@@ -265,10 +356,32 @@ Data::setContent(const Block& content)
   else {
     m_content = Block(tlv::Content, content);
   }
+  m_hasContentRoom = false;
 
   return *this;
 }
 
+uint8_t*
+Data::allocateContent(size_t length)
+{
+  onChanged();
+
+  OBufferStream header;
+  tlv::writeVarNumber(header, tlv::Content);
+  tlv::writeVarNumber(header, length);
+  ConstBufferPtr headerBuffer = header.buf();
+
+  BufferPtr buffer = make_shared<Buffer>(CONTENT_HEADROOM + headerBuffer->size() + length +
+                                         CONTENT_TAILROOM);
+  Buffer::iterator begin = buffer->begin() + CONTENT_HEADROOM;
+  Buffer::iterator valueBegin = std::copy(headerBuffer->begin(), headerBuffer->end(), begin);
+
+  m_content = Block(buffer, begin, valueBegin + length);
+  m_hasContentRoom = true;
+
+  return &*valueBegin;
+}
+
 Data&
 Data::setSignature(const Signature& signature)
 {
@@ -306,6 +419,9 @@ Data::onChanged()
   // !!!Note!!! Signature is not invalidated and it is responsibility of
   // the application to do proper re-signing if necessary
 
+  // fields that are still lazy must be decoded before the wire encoding goes away
+  decodeLazyFields(LAZY_NAME | LAZY_META_INFO | LAZY_SIGNATURE);
+
   m_wire.reset();
   m_fullName.clear();
 }
@@ -35,6 +35,11 @@
 namespace ndn {
 
 /** @brief represents a Data packet
+ *
+ *  After wireDecode, Name, MetaInfo, and Signature are materialized on first access through
+ *  the const getters, as is the full name by getFullName().  Concurrent const access to one
+ *  Data from several threads is therefore not thread-safe, unless these getters have been
+ *  called once before the Data is shared.
  */
 class Data : public TagHost, public enable_shared_from_this<Data>
 {
@@ -125,12 +130,35 @@ public:
    *     ...
    *     Block signatureValue = <sign_over_unsigned_portion>(encoder.buf(), encoder.size());
    *     data.wireEncode(encoder, signatureValue)
+   *
+   * The encoder should have enough room after the unsigned portion for @p signatureValue
+   * and before it for the outer TLV header; otherwise the encoding is reallocated.
+   * Name, MetaInfo, and Content are not decoded again from the result.
    */
   const Block&
   wireEncode(EncodingBuffer& encoder, const Block& signatureValue) const;
 
+  /**
+   * @brief Encode the unsigned portion around the content from allocateContent()
+   *
+   * @param encoder EncodingBuffer instance that is replaced with the encoder of the content
+   *                buffer, containing Name, MetaInfo, Content, and SignatureInfo (without
+   *                outer TLV header of the Data packet)
+   * @return false, leaving @p encoder untouched, if the content was not allocated with
+   *         allocateContent() or its buffer is in use by a previous encoding
+   *
+   * On success, the encoding can be finalized with wireEncode(EncodingBuffer&, const Block&)
+   * as after wireEncode(EncodingBuffer&, true).
+   */
+  bool
+  wireEncodeAroundContent(EncodingBuffer& encoder) const;
+
   /**
    * @brief Decode from the wire format
+   *
+   * Name, MetaInfo, and SignatureInfo are checked, but decoded only on first access.
+   *
+   * @throws tlv::Error if the wire format is not a valid Data packet
    */
   void
   wireDecode(const Block& wire);
@@ -168,6 +196,21 @@ public:
   const Name&
   getFullName() const;
 
+  /**
+   * @brief Create a copy of this Data packet whose wire encoding is held in a buffer of
+   *        exactly its size
+   *
+   * Storing the copy does not keep alive a larger buffer that the wire encoding of this
+   * packet is part of, e.g. a receive buffer or an encoding slab.  The full name, tags,
+   * and local control header are carried over; a full name already computed is not
+   * computed again, and the fields already decoded from the wire encoding of this packet
+   * are decoded in the copy as well.
+   *
+   * @throws Error if Data packet doesn't have wire encoding
+   */
+  shared_ptr<Data>
+  makeCompactCopy() const;
+
   /**
    * @brief Get MetaInfo block from Data packet
    */
@@ -268,6 +311,27 @@ public:
   Data&
   setContent(const ConstBufferPtr& contentValue);
 
+  /**
+   * @brief Allocate the content to be filled in place by the caller
+   *
+   * The content is placed in a buffer with room around it for the rest of the packet, so
+   * that wireEncode() and signing by KeyChain encode Name, MetaInfo, and Signature around
+   * the content instead of copying it:
+   *
+   *     Data data(name);
+   *     uint8_t* content = data.allocateContent(length);
+   *     file.read(reinterpret_cast<char*>(content), length);
+   *     keyChain.sign(data);
+   *
+   * The returned pointer is valid until the content is replaced; the content must not be
+   * modified after the packet is encoded.
+   *
+   * @param length size of the content
+   * @return pointer to the first byte of the content
+   */
+  uint8_t*
+  allocateContent(size_t length);
+
   //
 
   const Signature&
@@ -311,14 +375,43 @@ private:
   void
   onChanged();
 
+  /**
+   * @brief Fields that wireDecode located but has not decoded yet
+   */
+  enum LazyField {
+    LAZY_NAME      = 1 << 0,
+    LAZY_META_INFO = 1 << 1,
+    LAZY_SIGNATURE = 1 << 2
+  };
+
+  /**
+   * @brief Decode the specified lazy fields from the wire encoding
+   * @param fields bitwise OR of LazyField values; fields already decoded are skipped
+   */
+  void
+  decodeLazyFields(int fields) const;
+
+  /**
+   * @brief Room reserved by allocateContent() in front of the content for Data TLV header,
+   *        Name, and MetaInfo
+   */
+  static const size_t CONTENT_HEADROOM = 2048;
+
+  /**
+   * @brief Room reserved by allocateContent() after the content for Signature
+   */
+  static const size_t CONTENT_TAILROOM = 1024;
+
 private:
-  Name m_name;
-  MetaInfo m_metaInfo;
+  mutable Name m_name;
+  mutable MetaInfo m_metaInfo;
   mutable Block m_content;
-  Signature m_signature;
+  mutable Signature m_signature;
 
   mutable Block m_wire;
   mutable Name m_fullName;
+  mutable int m_lazyFields;
+  bool m_hasContentRoom;
 
   nfd::LocalControlHeader m_localControlHeader;
   friend class nfd::LocalControlHeader;
@@ -336,36 +429,42 @@ Data::hasWire() const
 inline const Name&
 Data::getName() const
 {
+  if (m_lazyFields & LAZY_NAME)
+    decodeLazyFields(LAZY_NAME);
   return m_name;
 }
 
 inline const MetaInfo&
 Data::getMetaInfo() const
 {
+  if (m_lazyFields & LAZY_META_INFO)
+    decodeLazyFields(LAZY_META_INFO);
   return m_metaInfo;
 }
 
 inline uint32_t
 Data::getContentType() const
 {
-  return m_metaInfo.getType();
+  return getMetaInfo().getType();
 }
 
 inline const time::milliseconds&
 Data::getFreshnessPeriod() const
 {
-  return m_metaInfo.getFreshnessPeriod();
+  return getMetaInfo().getFreshnessPeriod();
 }
 
 inline const name::Component&
 Data::getFinalBlockId() const
 {
-  return m_metaInfo.getFinalBlockId();
+  return getMetaInfo().getFinalBlockId();
 }
 
 inline const Signature&
 Data::getSignature() const
 {
+  if (m_lazyFields & LAZY_SIGNATURE)
+    decodeLazyFields(LAZY_SIGNATURE);
   return m_signature;
 }
 
@@ -26,7 +26,8 @@
 #include "../face.hpp"
 
 #include "registered-prefix.hpp"
-#include "pending-interest.hpp"
+#include "pending-interest-table.hpp"
+#include "interest-filter-table.hpp"
 
 #include "../util/scheduler.hpp"
 #include "../util/config-file.hpp"
@@ -43,8 +44,6 @@ namespace ndn {
 class Face::Impl : noncopyable
 {
 public:
-  typedef std::list<shared_ptr<PendingInterest> > PendingInterestTable;
-  typedef std::list<shared_ptr<InterestFilterRecord> > InterestFilterTable;
   typedef std::list<shared_ptr<RegisteredPrefix> > RegisteredPrefixTable;
 
   explicit
@@ -59,41 +58,26 @@ public:
   void
   satisfyPendingInterests(Data& data)
   {
-    for (PendingInterestTable::iterator i = m_pendingInterestTable.begin();
-         i != m_pendingInterestTable.end();
-         )
+    // Remove the matching PIT entries before calling the callbacks.
+    PendingInterestTable::EntryList entries = m_pendingInterestTable.extractMatching(data);
+
+    for (PendingInterestTable::EntryList::iterator i = entries.begin(); i != entries.end(); ++i)
       {
-        if ((*i)->getInterest()->matchesData(data))
-          {
-            // Copy pointers to the objects and remove the PIT entry before calling the callback.
-            OnData onData = (*i)->getOnData();
-            shared_ptr<const Interest> interest = (*i)->getInterest();
-
-            PendingInterestTable::iterator next = i;
-            ++next;
-            m_pendingInterestTable.erase(i);
-            i = next;
-
-            if (static_cast<bool>(onData)) {
-              onData(*interest, data);
-            }
-          }
-        else
-          ++i;
+        const OnData& onData = (*i)->getOnData();
+        if (static_cast<bool>(onData)) {
+          onData(*(*i)->getInterest(), data);
+        }
       }
   }
 
   void
   processInterestFilters(Interest& interest)
   {
-    for (InterestFilterTable::iterator i = m_interestFilterTable.begin();
-         i != m_interestFilterTable.end();
-         ++i)
+    InterestFilterTable::RecordList filters = m_interestFilterTable.findMatching(interest.getName());
+
+    for (InterestFilterTable::RecordList::iterator i = filters.begin(); i != filters.end(); ++i)
       {
-        if ((*i)->doesMatch(interest.getName()))
-          {
-            (**i)(interest);
-          }
+        (**i)(interest);
       }
   }
 
@@ -117,7 +101,7 @@ public:
   {
     this->ensureConnected();
 
-    m_pendingInterestTable.push_back(make_shared<PendingInterest>(interest, onData, onTimeout));
+    m_pendingInterestTable.insert(make_shared<PendingInterest>(interest, onData, onTimeout));
 
     if (!interest->getLocalControlHeader().empty(false, true))
       {
@@ -141,7 +125,7 @@ public:
   void
   asyncRemovePendingInterest(const PendingInterestId* pendingInterestId)
   {
-    m_pendingInterestTable.remove_if(MatchPendingInterestId(pendingInterestId));
+    m_pendingInterestTable.erase(pendingInterestId);
   }
 
   void
@@ -166,19 +150,13 @@ public:
   void
   asyncSetInterestFilter(const shared_ptr<InterestFilterRecord>& interestFilterRecord)
   {
-    m_interestFilterTable.push_back(interestFilterRecord);
+    m_interestFilterTable.insert(interestFilterRecord);
   }
 
   void
   asyncUnsetInterestFilter(const InterestFilterId* interestFilterId)
   {
-    InterestFilterTable::iterator i = std::find_if(m_interestFilterTable.begin(),
-                                                   m_interestFilterTable.end(),
-                                                   MatchInterestFilterId(interestFilterId));
-    if (i != m_interestFilterTable.end())
-      {
-        m_interestFilterTable.erase(i);
-      }
+    m_interestFilterTable.erase(interestFilterId);
   }
 
   /////////////////////////////////////////////////////////////////////////////////////////////////
@@ -241,7 +219,7 @@ public:
 
     if (static_cast<bool>(registeredPrefix->getFilter())) {
       // it was a combined operation
-      m_interestFilterTable.push_back(registeredPrefix->getFilter());
+      m_interestFilterTable.insert(registeredPrefix->getFilter());
     }
 
     if (static_cast<bool>(onSuccess)) {
@@ -263,7 +241,7 @@ public:
         if (static_cast<bool>(filter))
           {
             // it was a combined operation
-            m_interestFilterTable.remove(filter);
+            m_interestFilterTable.erase(filter);
           }
 
         (*i)->unregister(bind(&Impl::finalizeUnregisterPrefix, this, i, onSuccess),
@@ -306,20 +284,12 @@ public:
     // Check for PIT entry timeouts.
     time::steady_clock::TimePoint now = time::steady_clock::now();
 
-    PendingInterestTable::iterator i = m_pendingInterestTable.begin();
-    while (i != m_pendingInterestTable.end())
-      {
-        if ((*i)->isTimedOut(now))
-          {
-            // Save the PendingInterest and remove it from the PIT.  Then call the callback.
-            shared_ptr<PendingInterest> pendingInterest = *i;
+    // Save the timed out PendingInterests and remove them from the PIT.  Then call the callbacks.
+    PendingInterestTable::EntryList entries = m_pendingInterestTable.extractExpired(now);
 
-            i = m_pendingInterestTable.erase(i);
-
-            pendingInterest->callTimeout();
-          }
-        else
-          ++i;
+    for (PendingInterestTable::EntryList::iterator i = entries.begin(); i != entries.end(); ++i)
+      {
+        (*i)->callTimeout();
       }
 
     if (!m_pendingInterestTable.empty()) {
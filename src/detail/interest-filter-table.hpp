@@ -0,0 +1,228 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2014 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_DETAIL_INTEREST_FILTER_TABLE_HPP
+#define NDN_DETAIL_INTEREST_FILTER_TABLE_HPP
+
+#include "../common.hpp"
+#include "../interest-filter.hpp"
+#include "../name-view.hpp"
+#include "interest-filter-record.hpp"
+
+#include <algorithm>
+#include <list>
+#include <unordered_map>
+
+namespace ndn {
+
+/**
+ * @brief Table of Interest filters indexed by filter prefix
+ *
+ * Incoming Interests are dispatched by looking up every prefix of the Interest name in the
+ * prefix index, so the cost is proportional to the Interest name length rather than to the
+ * number of registered filters.  The index is a hash table keyed by NameView, so that the
+ * prefixes of the Interest name are looked up without building a Name for each of them.
+ * Regular expressions of regex-bearing filters are evaluated only for filters whose prefix
+ * matches the Interest name.
+ */
+class InterestFilterTable : noncopyable
+{
+public:
+  typedef std::vector<shared_ptr<InterestFilterRecord> > RecordList;
+
+  InterestFilterTable()
+    : m_lastSequence(0)
+  {
+  }
+
+  void
+  insert(const shared_ptr<InterestFilterRecord>& record)
+  {
+    if (m_recordIndex.count(record.get()) > 0)
+      return;
+
+    const Name& prefix = record->getFilter().getPrefix();
+    PrefixIndex::iterator bucket = m_prefixIndex.find(HashedNameView(NameView(prefix),
+                                                                     prefix.getHash()));
+    if (bucket == m_prefixIndex.end()) {
+      Bucket newBucket;
+      newBucket.prefixWire = prefix.wireEncode();
+      HashedNameView key(NameView(BlockView(newBucket.prefixWire)), prefix.getHash());
+      bucket = m_prefixIndex.insert(std::make_pair(key, newBucket)).first;
+    }
+    bucket->second.records.push_back(record);
+
+    Entry entry;
+    entry.bucket = &*bucket;
+    entry.position = --bucket->second.records.end();
+    entry.sequence = ++m_lastSequence;
+    m_recordIndex.insert(std::make_pair(record.get(), entry));
+  }
+
+  /**
+   * @brief Remove the filter with the specified id
+   * @return whether a filter was removed
+   */
+  bool
+  erase(const InterestFilterId* interestFilterId)
+  {
+    return erase(reinterpret_cast<const InterestFilterRecord*>(interestFilterId));
+  }
+
+  /**
+   * @brief Remove the specified filter record
+   * @return whether a filter was removed
+   */
+  bool
+  erase(const shared_ptr<InterestFilterRecord>& record)
+  {
+    return erase(record.get());
+  }
+
+  /**
+   * @brief Check if some filter could match @p name
+   *
+   * This is true if the prefix of some filter is a prefix of @p name.  Regular expressions
+   * are not evaluated.
+   */
+  bool
+  hasCandidates(const NameView& name) const
+  {
+    size_t prefixHash = 0;
+    for (NameView::const_iterator i = name.begin(); ; ++i) {
+      if (m_prefixIndex.count(HashedNameView(name.getPrefix(i), prefixHash)) > 0)
+        return true;
+      if (i == name.end())
+        return false;
+
+      prefixHash = NameView::combineHash(prefixHash, *i);
+    }
+  }
+
+  /**
+   * @brief Find all filters that match @p name
+   * @return matching filters, in the order they were inserted
+   */
+  RecordList
+  findMatching(const Name& name) const
+  {
+    std::vector<RecordIndex::const_iterator> matches;
+
+    NameView nameView(name);
+    size_t prefixSize = 0;
+    for (NameView::const_iterator i = nameView.begin(); ; ++i, ++prefixSize) {
+      HashedNameView prefix(nameView.getPrefix(i), name.getPrefixHash(prefixSize));
+      PrefixIndex::const_iterator bucket = m_prefixIndex.find(prefix);
+      if (bucket != m_prefixIndex.end()) {
+        const RecordBucket& records = bucket->second.records;
+        for (RecordBucket::const_iterator j = records.begin(); j != records.end(); ++j) {
+          if ((*j)->doesMatch(name))
+            matches.push_back(m_recordIndex.find(j->get()));
+        }
+      }
+
+      if (i == nameView.end())
+        break;
+    }
+
+    std::sort(matches.begin(), matches.end(), &isInsertedBefore);
+
+    RecordList records;
+    records.reserve(matches.size());
+    for (size_t i = 0; i < matches.size(); ++i) {
+      records.push_back(*matches[i]->second.position);
+    }
+    return records;
+  }
+
+  size_t
+  size() const
+  {
+    return m_recordIndex.size();
+  }
+
+  bool
+  empty() const
+  {
+    return m_recordIndex.empty();
+  }
+
+  void
+  clear()
+  {
+    m_recordIndex.clear();
+    m_prefixIndex.clear();
+  }
+
+private:
+  typedef std::list<shared_ptr<InterestFilterRecord> > RecordBucket;
+
+  struct Bucket
+  {
+    /// keeps alive the buffer that the NameView key of the bucket refers to
+    Block prefixWire;
+    RecordBucket records;
+  };
+
+  typedef std::unordered_map<HashedNameView, Bucket> PrefixIndex;
+
+  struct Entry
+  {
+    PrefixIndex::value_type* bucket; // iterators are invalidated by rehashing
+    RecordBucket::iterator position;
+    uint64_t sequence;
+  };
+
+  typedef std::unordered_map<const InterestFilterRecord*, Entry> RecordIndex;
+
+  static bool
+  isInsertedBefore(const RecordIndex::const_iterator& a, const RecordIndex::const_iterator& b)
+  {
+    return a->second.sequence < b->second.sequence;
+  }
+
+  bool
+  erase(const InterestFilterRecord* record)
+  {
+    RecordIndex::iterator i = m_recordIndex.find(record);
+    if (i == m_recordIndex.end())
+      return false;
+
+    Entry& entry = i->second;
+    entry.bucket->second.records.erase(entry.position);
+    if (entry.bucket->second.records.empty()) {
+      HashedNameView key = entry.bucket->first;
+      m_prefixIndex.erase(key);
+    }
+
+    m_recordIndex.erase(i);
+    return true;
+  }
+
+private:
+  PrefixIndex m_prefixIndex;
+  RecordIndex m_recordIndex;
+  uint64_t m_lastSequence;
+};
+
+} // namespace ndn
+
+#endif // NDN_DETAIL_INTEREST_FILTER_TABLE_HPP
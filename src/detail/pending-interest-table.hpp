@@ -0,0 +1,280 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2014 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_DETAIL_PENDING_INTEREST_TABLE_HPP
+#define NDN_DETAIL_PENDING_INTEREST_TABLE_HPP
+
+#include "../common.hpp"
+#include "../name-view.hpp"
+#include "pending-interest.hpp"
+
+#include <algorithm>
+#include <list>
+#include <map>
+#include <unordered_map>
+
+namespace ndn {
+
+/**
+ * @brief Table of pending Interests indexed by Interest name and by expiration time
+ *
+ * Incoming Data is dispatched by looking up every prefix of the Data name (and, when
+ * needed, the full name with implicit digest) in the name index, so the cost is
+ * proportional to the Data name length rather than to the number of pending Interests.
+ * The index is a hash table keyed by NameView, so that the prefixes of the Data name are
+ * looked up without building a Name for each of them.  Candidates found this way are still
+ * checked with Interest::matchesData, which takes care of selectors.  Expired entries are
+ * taken from the front of the expiration index.
+ */
+class PendingInterestTable : noncopyable
+{
+public:
+  typedef std::vector<shared_ptr<PendingInterest> > EntryList;
+
+  PendingInterestTable()
+    : m_nDigestEntries(0)
+    , m_lastSequence(0)
+  {
+  }
+
+  void
+  insert(const shared_ptr<PendingInterest>& entry)
+  {
+    const Name& name = entry->getInterest()->getName();
+    NameIndex::iterator bucket = m_nameIndex.find(HashedNameView(NameView(name),
+                                                                 name.getHash()));
+    if (bucket == m_nameIndex.end()) {
+      Bucket newBucket;
+      newBucket.nameWire = name.wireEncode();
+      HashedNameView key(NameView(BlockView(newBucket.nameWire)), name.getHash());
+      bucket = m_nameIndex.insert(std::make_pair(key, newBucket)).first;
+    }
+    bucket->second.entries.push_back(entry);
+
+    Record record;
+    record.bucket = &*bucket;
+    record.position = --bucket->second.entries.end();
+    record.expiry = m_expiryIndex.insert(std::make_pair(entry->getExpirationTime(),
+                                                        getId(*entry)));
+    record.sequence = ++m_lastSequence;
+    m_idIndex.insert(std::make_pair(getId(*entry), record));
+
+    if (isDigestName(name))
+      ++m_nDigestEntries;
+  }
+
+  /**
+   * @brief Remove the entry with the specified id
+   * @return whether an entry was removed
+   */
+  bool
+  erase(const PendingInterestId* pendingInterestId)
+  {
+    IdIndex::iterator i = m_idIndex.find(pendingInterestId);
+    if (i == m_idIndex.end())
+      return false;
+
+    eraseRecord(i);
+    return true;
+  }
+
+  /**
+   * @brief Check if some pending Interest could match a Data packet named @p dataName
+   *
+   * This is true if the name of some pending Interest is a prefix of @p dataName, or may be
+   * the full name of the Data packet.  Selectors are not checked.
+   */
+  bool
+  hasCandidates(const NameView& dataName) const
+  {
+    if (m_nDigestEntries > 0)
+      return true;
+
+    size_t prefixHash = 0;
+    for (NameView::const_iterator i = dataName.begin(); ; ++i) {
+      if (m_nameIndex.count(HashedNameView(dataName.getPrefix(i), prefixHash)) > 0)
+        return true;
+      if (i == dataName.end())
+        return false;
+
+      prefixHash = NameView::combineHash(prefixHash, *i);
+    }
+  }
+
+  /**
+   * @brief Remove all entries whose Interest matches @p data
+   * @return removed entries, in the order they were inserted
+   */
+  EntryList
+  extractMatching(const Data& data)
+  {
+    std::vector<IdIndex::iterator> matches;
+
+    const Name& name = data.getName();
+    NameView dataName(name);
+    size_t prefixSize = 0;
+    for (NameView::const_iterator i = dataName.begin(); ; ++i, ++prefixSize) {
+      HashedNameView prefix(dataName.getPrefix(i), name.getPrefixHash(prefixSize));
+      collectMatches(m_nameIndex.find(prefix), data, matches);
+      if (i == dataName.end())
+        break;
+    }
+
+    if (m_nDigestEntries > 0) {
+      const Name& fullName = data.getFullName();
+      collectMatches(m_nameIndex.find(HashedNameView(NameView(fullName), fullName.getHash())),
+                     data, matches);
+    }
+
+    std::sort(matches.begin(), matches.end(), &isInsertedBefore);
+
+    EntryList entries;
+    entries.reserve(matches.size());
+    for (std::vector<IdIndex::iterator>::iterator i = matches.begin(); i != matches.end(); ++i) {
+      entries.push_back(*(*i)->second.position);
+      eraseRecord(*i);
+    }
+    return entries;
+  }
+
+  /**
+   * @brief Remove all entries that have expired at @p now
+   * @return removed entries, in the order of their expiration time
+   */
+  EntryList
+  extractExpired(const time::steady_clock::TimePoint& now)
+  {
+    EntryList entries;
+    while (!m_expiryIndex.empty() && m_expiryIndex.begin()->first <= now) {
+      IdIndex::iterator i = m_idIndex.find(m_expiryIndex.begin()->second);
+      BOOST_ASSERT(i != m_idIndex.end());
+
+      entries.push_back(*i->second.position);
+      eraseRecord(i);
+    }
+    return entries;
+  }
+
+  size_t
+  size() const
+  {
+    return m_idIndex.size();
+  }
+
+  bool
+  empty() const
+  {
+    return m_idIndex.empty();
+  }
+
+  void
+  clear()
+  {
+    m_idIndex.clear();
+    m_expiryIndex.clear();
+    m_nameIndex.clear();
+    m_nDigestEntries = 0;
+  }
+
+private:
+  typedef std::list<shared_ptr<PendingInterest> > EntryBucket;
+
+  struct Bucket
+  {
+    /// keeps alive the buffer that the NameView key of the bucket refers to
+    Block nameWire;
+    EntryBucket entries;
+  };
+
+  typedef std::unordered_map<HashedNameView, Bucket> NameIndex;
+  typedef std::multimap<time::steady_clock::TimePoint, const PendingInterestId*> ExpiryIndex;
+
+  struct Record
+  {
+    NameIndex::value_type* bucket; // iterators are invalidated by rehashing
+    EntryBucket::iterator position;
+    ExpiryIndex::iterator expiry;
+    uint64_t sequence;
+  };
+
+  typedef std::unordered_map<const PendingInterestId*, Record> IdIndex;
+
+  static const PendingInterestId*
+  getId(const PendingInterest& entry)
+  {
+    return reinterpret_cast<const PendingInterestId*>(entry.getInterest().get());
+  }
+
+  static bool
+  isDigestName(const Name& name)
+  {
+    return !name.empty() && name.get(-1).isImplicitSha256Digest();
+  }
+
+  static bool
+  isInsertedBefore(const IdIndex::iterator& a, const IdIndex::iterator& b)
+  {
+    return a->second.sequence < b->second.sequence;
+  }
+
+  void
+  collectMatches(NameIndex::iterator bucket, const Data& data,
+                 std::vector<IdIndex::iterator>& matches)
+  {
+    if (bucket == m_nameIndex.end())
+      return;
+
+    const EntryBucket& entries = bucket->second.entries;
+    for (EntryBucket::const_iterator i = entries.begin(); i != entries.end(); ++i) {
+      if ((*i)->getInterest()->matchesData(data))
+        matches.push_back(m_idIndex.find(getId(**i)));
+    }
+  }
+
+  void
+  eraseRecord(IdIndex::iterator i)
+  {
+    Record& record = i->second;
+
+    if (isDigestName((*record.position)->getInterest()->getName()))
+      --m_nDigestEntries;
+
+    m_expiryIndex.erase(record.expiry);
+    record.bucket->second.entries.erase(record.position);
+    if (record.bucket->second.entries.empty()) {
+      HashedNameView key = record.bucket->first;
+      m_nameIndex.erase(key);
+    }
+
+    m_idIndex.erase(i);
+  }
+
+private:
+  NameIndex m_nameIndex;
+  ExpiryIndex m_expiryIndex;
+  IdIndex m_idIndex;
+  size_t m_nDigestEntries;
+  uint64_t m_lastSequence;
+};
+
+} // namespace ndn
+
+#endif // NDN_DETAIL_PENDING_INTEREST_TABLE_HPP
@@ -68,6 +68,15 @@ public:
     return m_onData;
   }
 
+  /**
+   * @brief Get the time point when this interest times out
+   */
+  const time::steady_clock::TimePoint&
+  getExpirationTime() const
+  {
+    return m_timeout;
+  }
+
   /**
    * Check if this interest is timed out.
    * @return true if this interest timed out, otherwise false.
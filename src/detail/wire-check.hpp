@@ -0,0 +1,171 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2014 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_DETAIL_WIRE_CHECK_HPP
+#define NDN_DETAIL_WIRE_CHECK_HPP
+
+#include "../common.hpp"
+#include "../encoding/block-helpers.hpp"
+#include "../exclude.hpp"
+#include "../signature-info.hpp"
+
+namespace ndn {
+namespace wire_check {
+
+/**
+ * @brief Structural checks of elements whose decoding is deferred
+ *
+ * Data and Interest locate some of their elements on wireDecode and materialize them on
+ * first access.  The functions below perform, without building the decoded objects, every
+ * check that the deferred decoding would perform, so that a malformed packet is still
+ * rejected by wireDecode and the deferred decoding itself cannot fail.  Sub-elements parsed
+ * here are kept in the supplied block and are not parsed again when materialized.
+ *
+ * Each function throws the same exception as the corresponding wireDecode.
+ */
+
+inline void
+checkName(const Block& wire)
+{
+  if (wire.type() != tlv::Name)
+    throw tlv::Error("Unexpected TLV type when decoding Name");
+
+  wire.parse();
+}
+
+inline void
+checkKeyLocator(const Block& wire)
+{
+  if (wire.type() != tlv::KeyLocator)
+    throw KeyLocator::Error("Unexpected TLV type during KeyLocator decoding");
+
+  wire.parse();
+
+  if (!wire.elements().empty() && wire.elements_begin()->type() == tlv::Name)
+    checkName(*wire.elements_begin());
+}
+
+inline void
+checkMetaInfo(const Block& wire)
+{
+  wire.parse();
+
+  Block::element_const_iterator val = wire.elements_begin();
+
+  if (val != wire.elements_end() && val->type() == tlv::ContentType) {
+    readNonNegativeInteger(*val);
+    ++val;
+  }
+
+  if (val != wire.elements_end() && val->type() == tlv::FreshnessPeriod) {
+    readNonNegativeInteger(*val);
+    ++val;
+  }
+
+  if (val != wire.elements_end() && val->type() == tlv::FinalBlockId) {
+    val->blockFromValue();
+  }
+}
+
+inline void
+checkSignatureInfo(const Block& wire)
+{
+  if (!wire.hasWire())
+    throw SignatureInfo::Error("The supplied block does not contain wire format");
+
+  wire.parse();
+
+  if (wire.type() != tlv::SignatureInfo)
+    throw tlv::Error("Unexpected TLV type when decoding Name");
+
+  Block::element_const_iterator it = wire.elements_begin();
+
+  if (it != wire.elements_end() && it->type() == tlv::SignatureType) {
+    readNonNegativeInteger(*it);
+    ++it;
+  }
+  else
+    throw SignatureInfo::Error("SignatureInfo does not have sub-TLV or the first sub-TLV "
+                               "is not SignatureType");
+
+  if (it != wire.elements_end() && it->type() == tlv::KeyLocator)
+    checkKeyLocator(*it);
+}
+
+inline void
+checkExclude(const Block& wire)
+{
+  if (wire.type() != tlv::Exclude)
+    throw tlv::Error("Unexpected TLV type when decoding Exclude");
+
+  wire.parse();
+
+  if (wire.elements_size() == 0)
+    throw Exclude::Error("Exclude element cannot be empty");
+
+  Block::element_const_iterator i = wire.elements_begin();
+  if (i->type() == tlv::Any)
+    ++i;
+
+  while (i != wire.elements_end())
+    {
+      if (i->type() != tlv::NameComponent)
+        throw Exclude::Error("Incorrect format of Exclude filter");
+      ++i;
+
+      if (i != wire.elements_end() && i->type() == tlv::Any)
+        ++i;
+    }
+}
+
+inline void
+checkSelectors(const Block& wire)
+{
+  if (wire.type() != tlv::Selectors)
+    throw tlv::Error("Unexpected TLV type when decoding Selectors");
+
+  wire.parse();
+
+  Block::element_const_iterator val = wire.find(tlv::MinSuffixComponents);
+  if (val != wire.elements_end())
+    readNonNegativeInteger(*val);
+
+  val = wire.find(tlv::MaxSuffixComponents);
+  if (val != wire.elements_end())
+    readNonNegativeInteger(*val);
+
+  val = wire.find(tlv::KeyLocator);
+  if (val != wire.elements_end())
+    checkKeyLocator(*val);
+
+  val = wire.find(tlv::Exclude);
+  if (val != wire.elements_end())
+    checkExclude(*val);
+
+  val = wire.find(tlv::ChildSelector);
+  if (val != wire.elements_end())
+    readNonNegativeInteger(*val);
+}
+
+} // namespace wire_check
+} // namespace ndn
+
+#endif // NDN_DETAIL_WIRE_CHECK_HPP
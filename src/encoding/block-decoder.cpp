@@ -0,0 +1,227 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2014 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "block-decoder.hpp"
+
+#include "tlv.hpp"
+
+#include <boost/lexical_cast.hpp>
+
+namespace ndn {
+
+/** @brief Room for TLV-TYPE and TLV-LENGTH reserved in a buffer owned by the decoder
+ */
+static const size_t MAX_HEADER_SIZE = 2 * 9;
+
+static size_t
+sizeOfVarNumberFromFirstOctet(uint8_t firstOctet)
+{
+  switch (firstOctet) {
+  case 253:
+    return 3;
+  case 254:
+    return 5;
+  case 255:
+    return 9;
+  default:
+    return 1;
+  }
+}
+
+BlockDecoder::BlockDecoder(const ElementCallback& onElement, size_t maxElementSize)
+  : m_onElement(onElement)
+  , m_maxElementSize(maxElementSize)
+{
+  reset();
+}
+
+void
+BlockDecoder::reset()
+{
+  m_state = STATE_TYPE_OCTET;
+  m_buffer.reset();
+  m_ownBuffer.reset();
+  m_offset = 0;
+  m_size = 0;
+  m_neededSize = 1;
+  m_typeSize = 0;
+  m_type = 0;
+  m_valueOffset = 0;
+}
+
+void
+BlockDecoder::decode(const ConstBufferPtr& buffer,
+                     Buffer::const_iterator begin, Buffer::const_iterator end)
+{
+  // the pending bytes can stay in place only if this chunk directly follows them
+  if (m_size > 0 && m_ownBuffer == nullptr &&
+      (buffer != m_buffer || begin != m_buffer->begin() + m_offset + m_size))
+    ownPendingBytes();
+
+  while (begin != end)
+    {
+      size_t nBytes = 0;
+      if (m_ownBuffer != nullptr)
+        {
+          nBytes = reserveOwnBuffer(end - begin);
+          std::copy(begin, begin + nBytes, m_ownBuffer->begin() + m_size);
+        }
+      else
+        {
+          if (m_size == 0)
+            {
+              m_buffer = buffer;
+              m_offset = begin - buffer->begin();
+            }
+          nBytes = std::min(getNeededSize(), static_cast<size_t>(end - begin));
+        }
+
+      begin += nBytes;
+      m_size += nBytes;
+      if (m_size == m_neededSize)
+        onNeededBytes();
+    }
+}
+
+void
+BlockDecoder::decode(const uint8_t* buffer, size_t size)
+{
+  const uint8_t* end = buffer + size;
+  while (buffer != end)
+    {
+      if (m_ownBuffer == nullptr)
+        ownPendingBytes();
+
+      size_t nBytes = reserveOwnBuffer(end - buffer);
+      std::copy(buffer, buffer + nBytes, m_ownBuffer->begin() + m_size);
+
+      buffer += nBytes;
+      m_size += nBytes;
+      if (m_size == m_neededSize)
+        onNeededBytes();
+    }
+}
+
+bool
+BlockDecoder::decode(std::istream& is)
+{
+  while (true)
+    {
+      if (m_ownBuffer == nullptr)
+        ownPendingBytes();
+
+      size_t nBytes = reserveOwnBuffer(getNeededSize());
+      is.read(reinterpret_cast<char*>(&(*m_ownBuffer)[m_size]), nBytes);
+
+      size_t nBytesRead = static_cast<size_t>(is.gcount());
+      m_size += nBytesRead;
+      if (nBytesRead < nBytes)
+        return false;
+
+      if (m_size == m_neededSize && onNeededBytes())
+        return true;
+    }
+}
+
+void
+BlockDecoder::ownPendingBytes()
+{
+  BufferPtr ownBuffer = make_shared<Buffer>();
+  ownBuffer->reserve(MAX_HEADER_SIZE);
+  if (m_size > 0)
+    ownBuffer->assign(m_buffer->begin() + m_offset, m_buffer->begin() + m_offset + m_size);
+
+  m_buffer = m_ownBuffer = ownBuffer;
+  m_offset = 0;
+}
+
+size_t
+BlockDecoder::reserveOwnBuffer(size_t size)
+{
+  size_t wantedSize = m_size + std::min(size, getNeededSize());
+  if (m_ownBuffer->size() < wantedSize)
+    {
+      // an element up to the packet size is allocated at once; a larger element grows with
+      // the arriving bytes, so that a bogus TLV-LENGTH does not allocate memory that the
+      // input never fills
+      size_t newSize = std::max(wantedSize,
+                                std::max(2 * m_ownBuffer->size(), MAX_NDN_PACKET_SIZE));
+      m_ownBuffer->resize(std::min(newSize, m_neededSize));
+    }
+  return wantedSize - m_size;
+}
+
+bool
+BlockDecoder::onNeededBytes()
+{
+  Buffer::const_iterator begin = m_buffer->begin() + m_offset;
+
+  switch (m_state) {
+  case STATE_TYPE_OCTET:
+    m_typeSize = sizeOfVarNumberFromFirstOctet(*begin);
+    m_state = STATE_LENGTH_OCTET;
+    m_neededSize = m_typeSize + 1;
+    return false;
+
+  case STATE_LENGTH_OCTET:
+    m_state = STATE_LENGTH;
+    m_neededSize = m_typeSize + sizeOfVarNumberFromFirstOctet(begin[m_typeSize]);
+    if (m_size < m_neededSize)
+      return false;
+    // fall through: TLV-LENGTH is a single octet
+
+  case STATE_LENGTH:
+    {
+      Buffer::const_iterator valueBegin = begin;
+      uint64_t length = 0;
+      if (!tlv::readType(valueBegin, begin + m_size, m_type) ||
+          !tlv::readVarNumber(valueBegin, begin + m_size, length))
+        {
+          reset();
+          throw Error("TLV-TYPE of the element is out of range");
+        }
+
+      m_valueOffset = m_size;
+      if (m_valueOffset > m_maxElementSize || length > m_maxElementSize - m_valueOffset)
+        {
+          reset();
+          throw Error("Element is larger than " +
+                      boost::lexical_cast<std::string>(m_maxElementSize) + " octets");
+        }
+
+      m_state = STATE_VALUE;
+      m_neededSize = m_valueOffset + static_cast<size_t>(length);
+      if (m_size < m_neededSize)
+        return false;
+    }
+    // fall through: TLV-VALUE is empty
+
+  case STATE_VALUE:
+    break;
+  }
+
+  Block element(m_buffer, m_type, begin, begin + m_size, begin + m_valueOffset, begin + m_size);
+  reset();
+  m_onElement(element);
+  return true;
+}
+
+} // namespace ndn
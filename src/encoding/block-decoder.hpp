@@ -0,0 +1,161 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2014 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_ENCODING_BLOCK_DECODER_HPP
+#define NDN_ENCODING_BLOCK_DECODER_HPP
+
+#include "../common.hpp"
+
+#include "block.hpp"
+
+namespace ndn {
+
+/** @brief Incremental decoder of a stream of top-level TLV elements
+ *
+ *  Input is fed in chunks of any size, and every complete element is passed to the
+ *  element callback as a Block.  The decoder keeps the parsing state of an incomplete
+ *  element between chunks, so each input byte is examined only once.
+ *
+ *  Elements fed from a shared buffer refer to that buffer without copying, including an
+ *  element continued by the next chunk fed from the same buffer right after the previous
+ *  one.  Otherwise, the bytes of an incomplete element are copied once into a buffer of
+ *  the element's size.
+ */
+class BlockDecoder : noncopyable
+{
+public:
+  typedef Block::Error Error;
+
+  typedef function<void(const Block& element)> ElementCallback;
+
+  /** @brief Create a decoder
+   *  @param onElement called with every complete element
+   *  @param maxElementSize maximum size of an element, including its TLV-TYPE and TLV-LENGTH
+   */
+  explicit
+  BlockDecoder(const ElementCallback& onElement,
+               size_t maxElementSize = MAX_NDN_PACKET_SIZE);
+
+  /** @brief Decode the bytes in [begin, end) of @p buffer
+   *
+   *  Complete elements refer to @p buffer.  The buffer must not be modified while the
+   *  decoder or any delivered element refers to it.
+   *
+   *  @throw Error the input is not a valid TLV element or the element is larger than
+   *               the maximum size; the decoder is reset
+   */
+  void
+  decode(const ConstBufferPtr& buffer,
+         Buffer::const_iterator begin, Buffer::const_iterator end);
+
+  /** @brief Decode a chunk of raw bytes, which are copied
+   *  @throw Error the input is not a valid TLV element or the element is larger than
+   *               the maximum size; the decoder is reset
+   */
+  void
+  decode(const uint8_t* buffer, size_t size);
+
+  /** @brief Decode one element from @p is
+   *
+   *  Exactly the bytes of the element are extracted from the stream, directly into the
+   *  buffer of the element.
+   *
+   *  @return true if an element was completed, false if the stream ended before
+   *  @throw Error the input is not a valid TLV element or the element is larger than
+   *               the maximum size; the decoder is reset
+   */
+  bool
+  decode(std::istream& is);
+
+  /** @brief Discard the incomplete element, if any
+   */
+  void
+  reset();
+
+  /** @brief Check if some bytes of an incomplete element have been decoded
+   */
+  bool
+  hasPendingElement() const;
+
+  /** @brief Get the number of bytes needed before the decoder can make progress
+   *
+   *  Unless the element is complete, feeding fewer bytes only buffers them.
+   */
+  size_t
+  getNeededSize() const;
+
+private:
+  /** @brief Start keeping the bytes of the incomplete element in a buffer of its own
+   */
+  void
+  ownPendingBytes();
+
+  /** @brief Make sure the own buffer has room for @p size more bytes of the element
+   *  @return room in the own buffer past the pending bytes, at most the bytes still needed
+   */
+  size_t
+  reserveOwnBuffer(size_t size);
+
+  /** @brief Advance parsing once the needed bytes have arrived
+   *  @return true if the element was delivered
+   */
+  bool
+  onNeededBytes();
+
+  /** @brief Stages of decoding an element
+   */
+  enum State {
+    STATE_TYPE_OCTET,   ///< expecting the first octet of TLV-TYPE
+    STATE_LENGTH_OCTET, ///< expecting TLV-TYPE and the first octet of TLV-LENGTH
+    STATE_LENGTH,       ///< expecting the rest of TLV-LENGTH
+    STATE_VALUE         ///< expecting the rest of TLV-VALUE
+  };
+
+private:
+  ElementCallback m_onElement;
+  size_t m_maxElementSize;
+
+  State m_state;
+  ConstBufferPtr m_buffer; ///< buffer holding the pending bytes of the element
+  BufferPtr m_ownBuffer;   ///< m_buffer, if owned by the decoder
+  size_t m_offset;         ///< offset of the element in m_buffer
+  size_t m_size;           ///< number of pending bytes of the element
+  size_t m_neededSize;     ///< number of pending bytes needed to advance m_state
+  size_t m_typeSize;       ///< size of TLV-TYPE, once known
+  uint32_t m_type;
+  size_t m_valueOffset;    ///< offset of TLV-VALUE in the element, once known
+};
+
+inline bool
+BlockDecoder::hasPendingElement() const
+{
+  return m_size > 0;
+}
+
+inline size_t
+BlockDecoder::getNeededSize() const
+{
+  return m_neededSize - m_size;
+}
+
+} // namespace ndn
+
+#endif // NDN_ENCODING_BLOCK_DECODER_HPP
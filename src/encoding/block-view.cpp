@@ -0,0 +1,115 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2014 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "block-view.hpp"
+
+#include "tlv.hpp"
+
+namespace ndn {
+
+BlockView::BlockView(const uint8_t* buffer, size_t maxSize)
+{
+  if (!fromBuffer(buffer, maxSize, *this))
+    throw Error("Cannot parse TLV element from the buffer");
+}
+
+BlockView::BlockView(const Block& block)
+{
+  if (!block.hasWire())
+    throw Error("Block does not have wire encoding");
+
+  *this = BlockView(block.type(), block.wire(), block.value(), block.wire() + block.size());
+}
+
+bool
+BlockView::fromBuffer(const uint8_t* buffer, size_t maxSize, BlockView& view)
+{
+  const uint8_t* position = buffer;
+  const uint8_t* end = buffer + maxSize;
+
+  uint32_t type = 0;
+  if (!tlv::readType(position, end, type))
+    return false;
+
+  uint64_t length = 0;
+  if (!tlv::readVarNumber(position, end, length))
+    return false;
+
+  if (length > static_cast<uint64_t>(end - position))
+    return false;
+
+  view = BlockView(type, buffer, position, position + length);
+  return true;
+}
+
+BlockView
+BlockView::find(uint32_t type) const
+{
+  for (const_iterator i = elements_begin(); i != elements_end(); ++i) {
+    if (i->type() == type)
+      return *i;
+  }
+  return BlockView();
+}
+
+Block
+BlockView::toBlock() const
+{
+  if (empty())
+    return Block();
+
+  return Block(m_begin, size());
+}
+
+Block
+BlockView::toBlock(const ConstBufferPtr& buffer) const
+{
+  if (empty())
+    return Block();
+
+  BOOST_ASSERT(buffer->buf() <= m_begin && m_end <= buffer->buf() + buffer->size());
+
+  Buffer::const_iterator begin = buffer->begin() + (m_begin - buffer->buf());
+  return Block(buffer, m_type,
+               begin, begin + size(),
+               begin + (m_valueBegin - m_begin), begin + size());
+}
+
+bool
+BlockView::operator==(const BlockView& other) const
+{
+  return size() == other.size() &&
+         (size() == 0 || std::memcmp(m_begin, other.m_begin, size()) == 0);
+}
+
+void
+BlockView::const_iterator::parseElement(const uint8_t* position)
+{
+  if (position == m_end) {
+    m_element = BlockView(std::numeric_limits<uint32_t>::max(), m_end, m_end, m_end);
+    return;
+  }
+
+  if (!fromBuffer(position, m_end - position, m_element))
+    throw Error("Cannot parse sub-element of the TLV element");
+}
+
+} // namespace ndn
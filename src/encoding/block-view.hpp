@@ -0,0 +1,330 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2014 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_ENCODING_BLOCK_VIEW_HPP
+#define NDN_ENCODING_BLOCK_VIEW_HPP
+
+#include "../common.hpp"
+
+#include "block.hpp"
+
+#include <iterator>
+
+namespace ndn {
+
+/** @brief Non-owning view of a TLV element in a wire buffer
+ *
+ *  BlockView holds only pointers into the wire buffer and the TLV type, so it is trivially
+ *  copyable and cheap to pass by value.  Sub-elements are parsed on the fly while iterating,
+ *  without allocating.  The caller must keep the underlying buffer alive while any view
+ *  into it is in use; an owning Block can be materialized with toBlock().
+ */
+class BlockView
+{
+public:
+  typedef Block::Error Error;
+
+  class const_iterator;
+
+public: // constructor
+  /** @brief Create an empty view
+   */
+  BlockView();
+
+  /** @brief Create a view of the TLV element at the start of the buffer
+   *  @throw Error the buffer does not start with a complete TLV element
+   */
+  BlockView(const uint8_t* buffer, size_t maxSize);
+
+  /** @brief Create a view of the wire encoding of @p block
+   *  @throw Error @p block does not have wire encoding
+   */
+  explicit
+  BlockView(const Block& block);
+
+  /** @brief Try to create a view of the TLV element at the start of the buffer
+   *
+   *  This method does not throw upon decoding error.
+   *  @return true if the view was created, false if the buffer does not start with a
+   *          complete TLV element
+   */
+  static bool
+  fromBuffer(const uint8_t* buffer, size_t maxSize, BlockView& view);
+
+public: // wire format
+  bool
+  empty() const;
+
+  uint32_t
+  type() const;
+
+  const uint8_t*
+  begin() const;
+
+  const uint8_t*
+  end() const;
+
+  const uint8_t*
+  wire() const;
+
+  size_t
+  size() const;
+
+  const uint8_t*
+  value_begin() const;
+
+  const uint8_t*
+  value_end() const;
+
+  const uint8_t*
+  value() const;
+
+  size_t
+  value_size() const;
+
+public: // sub elements
+  /** @brief Iterate over the sub-elements, parsing them on the fly
+   *  @note Incrementing an iterator throws Error if the value is not a sequence of TLV elements
+   */
+  const_iterator
+  elements_begin() const;
+
+  const_iterator
+  elements_end() const;
+
+  /** @brief Get the first sub-element of the requested type
+   *  @return the sub-element, or an empty view if there is none
+   *  @throw Error the value is not a sequence of TLV elements
+   */
+  BlockView
+  find(uint32_t type) const;
+
+public: // materialization
+  /** @brief Create an owning Block holding a copy of the wire encoding
+   */
+  Block
+  toBlock() const;
+
+  /** @brief Create a Block that shares @p buffer, which must contain this view
+   */
+  Block
+  toBlock(const ConstBufferPtr& buffer) const;
+
+public: // EqualityComparable concept
+  /** @brief Compare wire encodings
+   */
+  bool
+  operator==(const BlockView& other) const;
+
+  bool
+  operator!=(const BlockView& other) const;
+
+private:
+  BlockView(uint32_t type, const uint8_t* begin, const uint8_t* valueBegin, const uint8_t* end);
+
+private:
+  const uint8_t* m_begin;
+  const uint8_t* m_valueBegin;
+  const uint8_t* m_end;
+  uint32_t m_type;
+};
+
+/** @brief Forward iterator over the sub-elements of a BlockView
+ */
+class BlockView::const_iterator : public std::iterator<std::forward_iterator_tag,
+                                                       const BlockView>
+{
+public:
+  const_iterator();
+
+  const_iterator(const uint8_t* position, const uint8_t* end);
+
+  reference
+  operator*() const
+  {
+    return m_element;
+  }
+
+  pointer
+  operator->() const
+  {
+    return &m_element;
+  }
+
+  const_iterator&
+  operator++();
+
+  const_iterator
+  operator++(int);
+
+  bool
+  operator==(const const_iterator& other) const
+  {
+    return m_element.m_begin == other.m_element.m_begin;
+  }
+
+  bool
+  operator!=(const const_iterator& other) const
+  {
+    return !(*this == other);
+  }
+
+private:
+  void
+  parseElement(const uint8_t* position);
+
+private:
+  BlockView m_element;
+  const uint8_t* m_end;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+inline
+BlockView::BlockView()
+  : m_begin(0)
+  , m_valueBegin(0)
+  , m_end(0)
+  , m_type(std::numeric_limits<uint32_t>::max())
+{
+}
+
+inline
+BlockView::BlockView(uint32_t type,
+                     const uint8_t* begin, const uint8_t* valueBegin, const uint8_t* end)
+  : m_begin(begin)
+  , m_valueBegin(valueBegin)
+  , m_end(end)
+  , m_type(type)
+{
+}
+
+inline bool
+BlockView::empty() const
+{
+  return m_type == std::numeric_limits<uint32_t>::max();
+}
+
+inline uint32_t
+BlockView::type() const
+{
+  return m_type;
+}
+
+inline const uint8_t*
+BlockView::begin() const
+{
+  return m_begin;
+}
+
+inline const uint8_t*
+BlockView::end() const
+{
+  return m_end;
+}
+
+inline const uint8_t*
+BlockView::wire() const
+{
+  return m_begin;
+}
+
+inline size_t
+BlockView::size() const
+{
+  return m_end - m_begin;
+}
+
+inline const uint8_t*
+BlockView::value_begin() const
+{
+  return m_valueBegin;
+}
+
+inline const uint8_t*
+BlockView::value_end() const
+{
+  return m_end;
+}
+
+inline const uint8_t*
+BlockView::value() const
+{
+  return m_valueBegin;
+}
+
+inline size_t
+BlockView::value_size() const
+{
+  return m_end - m_valueBegin;
+}
+
+inline BlockView::const_iterator
+BlockView::elements_begin() const
+{
+  return const_iterator(m_valueBegin, m_end);
+}
+
+inline BlockView::const_iterator
+BlockView::elements_end() const
+{
+  return const_iterator(m_end, m_end);
+}
+
+inline bool
+BlockView::operator!=(const BlockView& other) const
+{
+  return !this->operator==(other);
+}
+
+inline
+BlockView::const_iterator::const_iterator()
+  : m_end(0)
+{
+}
+
+inline
+BlockView::const_iterator::const_iterator(const uint8_t* position, const uint8_t* end)
+  : m_end(end)
+{
+  parseElement(position);
+}
+
+inline BlockView::const_iterator&
+BlockView::const_iterator::operator++()
+{
+  parseElement(m_element.m_end);
+  return *this;
+}
+
+inline BlockView::const_iterator
+BlockView::const_iterator::operator++(int)
+{
+  const_iterator copy(*this);
+  ++*this;
+  return copy;
+}
+
+} // namespace ndn
+
+#endif // NDN_ENCODING_BLOCK_VIEW_HPP
@@ -23,6 +23,7 @@
 
 #include "block.hpp"
 #include "block-helpers.hpp"
+#include "block-decoder.hpp"
 
 #include "tlv.hpp"
 #include "encoding-buffer.hpp"
@@ -43,8 +44,6 @@ static_assert(std::is_move_assignable<Buffer>::value,
               "Buffer must be MoveAssignable");
 #endif // NDN_CXX_HAVE_IS_MOVE_ASSIGNABLE
 
-const size_t MAX_SIZE_OF_BLOCK_FROM_STREAM = 8800;
-
 Block::Block()
   : m_type(std::numeric_limits<uint32_t>::max())
 {
@@ -199,27 +198,13 @@ Block::Block(uint32_t type, const Block& value)
 Block
 Block::fromStream(std::istream& is)
 {
-  std::istream_iterator<uint8_t> tmp_begin(is);
-  std::istream_iterator<uint8_t> tmp_end;
-
-  uint32_t type = tlv::readType(tmp_begin, tmp_end);
-  uint64_t length = tlv::readVarNumber(tmp_begin, tmp_end);
-
-  if (length > MAX_SIZE_OF_BLOCK_FROM_STREAM)
-    throw tlv::Error("Length of block from stream is too large");
-
-  // We may still have some problem here, if some exception happens,
-  // we may completely lose all the bytes extracted from the stream.
-
-  char buf[MAX_SIZE_OF_BLOCK_FROM_STREAM];
-  buf[0] = *tmp_begin;
-  is.read(buf+1, length-1);
-
-  if (length != static_cast<uint64_t>(is.gcount()) + 1) {
-    throw tlv::Error("Not enough data in the buffer to fully parse TLV");
-  }
+  Block element;
+  BlockDecoder decoder([&element] (const Block& block) { element = block; },
+                       std::numeric_limits<size_t>::max());
+  if (!decoder.decode(is))
+    throw tlv::Error("Not enough data in the stream to fully parse TLV");
 
-  return dataBlock(type, buf, length);
+  return element;
 }
 
 bool
@@ -304,29 +289,45 @@ Block::parse() const
   if (!m_subBlocks.empty() || value_size() == 0)
     return;
 
-  Buffer::const_iterator begin = value_begin();
-  Buffer::const_iterator end = value_end();
+  // The elements are located twice over raw pointers: the first sweep validates the
+  // headers and counts the elements, so that the second one can fill a vector that is
+  // allocated only once.
+  const uint8_t* const valueBegin = &*value_begin();
+  const uint8_t* const valueEnd = valueBegin + value_size();
 
-  while (begin != end)
+  size_t nElements = 0;
+  for (const uint8_t* begin = valueBegin; begin != valueEnd; ++nElements)
     {
-      Buffer::const_iterator element_begin = begin;
+      tlv::readType(begin, valueEnd);
+      uint64_t length = tlv::readVarNumber(begin, valueEnd);
 
-      uint32_t type = tlv::readType(begin, end);
-      uint64_t length = tlv::readVarNumber(begin, end);
-
-      if (length > static_cast<uint64_t>(end - begin))
+      if (length > static_cast<uint64_t>(valueEnd - begin))
         {
-          m_subBlocks.clear();
           throw tlv::Error("TLV length exceeds buffer length");
         }
-      Buffer::const_iterator element_end = begin + length;
+      begin += length;
+    }
+
+  m_subBlocks.reserve(nElements);
+
+  for (const uint8_t* begin = valueBegin; begin != valueEnd; )
+    {
+      const uint8_t* elementBegin = begin;
+
+      uint32_t type = 0;
+      uint64_t length = 0;
+      tlv::readType(begin, valueEnd, type);
+      tlv::readVarNumber(begin, valueEnd, length);
+      const uint8_t* elementEnd = begin + length;
 
       m_subBlocks.push_back(Block(m_buffer,
                                   type,
-                                  element_begin, element_end,
-                                  begin, element_end));
+                                  value_begin() + (elementBegin - valueBegin),
+                                  value_begin() + (elementEnd - valueBegin),
+                                  value_begin() + (begin - valueBegin),
+                                  value_begin() + (elementEnd - valueBegin)));
 
-      begin = element_end;
+      begin = elementEnd;
       // don't do recursive parsing, just the top level
     }
 }
@@ -131,6 +131,9 @@ public: // constructor, creation, assignment
   }
 
   /** @brief Create a Block from an input stream
+   *
+   *  Exactly the bytes of the element are extracted, and the element may be of any size.
+   *  @throw tlv::Error the stream does not contain a complete TLV element
    */
   static Block
   fromStream(std::istream& is);
@@ -172,6 +175,11 @@ public: // wire format
   void
   resetWire();
 
+  /** @brief Get the underlying buffer, which may extend beyond the element
+   */
+  ConstBufferPtr
+  getBuffer() const;
+
   Buffer::const_iterator
   begin() const;
 
@@ -316,6 +324,12 @@ Block::end() const
   return m_end;
 }
 
+inline ConstBufferPtr
+Block::getBuffer() const
+{
+  return m_buffer;
+}
+
 inline const uint8_t*
 Block::wire() const
 {
@@ -0,0 +1,100 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2014 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "encoding-buffer.hpp"
+
+namespace ndn {
+
+namespace {
+
+/**
+ * @brief Size of the slabs handed out to pooled EncodingBuffers
+ *
+ * Large enough for a packet of maximum size, so that most encodings never leave the slab.
+ */
+const size_t SLAB_SIZE = MAX_NDN_PACKET_SIZE;
+
+/**
+ * @brief A slab is not worth continuing once less than this much of it is free
+ */
+const size_t MIN_SLAB_FREE_SPACE = 1024;
+
+#ifdef NDN_CXX_HAVE_CXX_THREAD_LOCAL
+
+struct SlabPool
+{
+  SlabPool()
+    : freeSpace(0)
+  {
+  }
+
+  BufferPtr slab; ///< slab to continue with, or nullptr while it is lent out
+  size_t freeSpace;
+};
+
+thread_local SlabPool g_slabPool;
+
+#endif // NDN_CXX_HAVE_CXX_THREAD_LOCAL
+
+} // namespace
+
+BufferPtr
+EncodingImpl<encoding::Buffer>::acquireSlab(size_t& freeSpace)
+{
+#ifdef NDN_CXX_HAVE_CXX_THREAD_LOCAL
+  BufferPtr slab;
+  slab.swap(g_slabPool.slab);
+
+  if (static_cast<bool>(slab)) {
+    if (slab.use_count() == 1) {
+      // no Block refers to the slab anymore, so it can be rewritten from the back
+      freeSpace = slab->size();
+      return slab;
+    }
+    if (g_slabPool.freeSpace >= MIN_SLAB_FREE_SPACE) {
+      freeSpace = g_slabPool.freeSpace;
+      return slab;
+    }
+  }
+
+  freeSpace = SLAB_SIZE;
+  return make_shared<Buffer>(SLAB_SIZE);
+#else
+  // no slab can be shared, so a whole slab is allocated only when the size is unknown
+  if (freeSpace == 0)
+    freeSpace = SLAB_SIZE;
+  return make_shared<Buffer>(freeSpace);
+#endif // NDN_CXX_HAVE_CXX_THREAD_LOCAL
+}
+
+void
+EncodingImpl<encoding::Buffer>::releaseSlab(const BufferPtr& slab, size_t freeSpace)
+{
+#ifdef NDN_CXX_HAVE_CXX_THREAD_LOCAL
+  // a nested encoding may have returned its slab in the meantime; keep the roomier one
+  if (!static_cast<bool>(g_slabPool.slab) || freeSpace > g_slabPool.freeSpace) {
+    g_slabPool.slab = slab;
+    g_slabPool.freeSpace = freeSpace;
+  }
+#endif // NDN_CXX_HAVE_CXX_THREAD_LOCAL
+}
+
+} // namespace ndn
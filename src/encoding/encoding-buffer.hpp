@@ -35,6 +35,16 @@ namespace ndn {
 namespace encoding {
 static const bool Buffer = true;
 static const bool Estimator = false;
+
+/**
+ * @brief Tag selecting the EncodingBuffer constructor that prepends into a slab
+ *        recycled from the calling thread's pool
+ */
+struct PooledTag
+{
+};
+
+static const PooledTag Pooled = PooledTag();
 } // encoding
 
 template<bool isRealEncoderNotEstimator>
@@ -59,10 +69,43 @@ public:
   EncodingImpl(size_t totalReserve = 8800,
                size_t reserveFromBack = 400)
     : m_buffer(new Buffer(totalReserve))
+    , m_isPooled(false)
+    , m_isBorrowingSlab(false)
   {
     m_begin = m_end = m_buffer->end() - (reserveFromBack < totalReserve ? reserveFromBack : 0);
   }
 
+  /**
+   * @brief Create EncodingBuffer that prepends into a slab of the calling thread's pool
+   *
+   * No size estimation pass is needed: the encoder starts in the free part of the
+   * current slab and moves to a private buffer only if the encoding outgrows it.
+   * Consecutive encodings are packed into the same slab, and Blocks obtained from
+   * block() share it.  A slab is written again only after no Block refers to it.
+   *
+   * Because the Blocks share the slab, one long-lived Block keeps the whole slab alive,
+   * however small it is.  Copy such a Block into a buffer of its own size before keeping
+   * it for long.
+   *
+   * This constructor is intended for prepend-only encoding; the first append operation
+   * moves the encoding into a private buffer.
+   *
+   * Without thread-local storage (NDN_CXX_HAVE_CXX_THREAD_LOCAL) there is no pool, and
+   * every encoder gets a private buffer of @p sizeHint bytes, or of a whole slab if the
+   * hint is 0.  Callers that can bound the size of the encoding should pass the bound.
+   *
+   * @param sizeHint upper bound of the encoding size, or 0 if unknown
+   */
+  explicit
+  EncodingImpl(encoding::PooledTag, size_t sizeHint = 0)
+    : m_isPooled(true)
+    , m_isBorrowingSlab(true)
+  {
+    size_t freeSpace = sizeHint;
+    m_buffer = acquireSlab(freeSpace);
+    m_begin = m_end = m_buffer->begin() + freeSpace;
+  }
+
   /**
    * @brief Create EncodingBlock from existing block
    *
@@ -78,9 +121,45 @@ public:
     : m_buffer(const_pointer_cast<Buffer>(block.m_buffer))
     , m_begin(m_buffer->begin() + (block.begin() - m_buffer->begin()))
     , m_end(m_buffer->begin()   + (block.end()   - m_buffer->begin()))
+    , m_isPooled(false)
+    , m_isBorrowingSlab(false)
+  {
+  }
+
+  /**
+   * @brief Copy the encoder state
+   *
+   * Only the original returns the slab to the pool, so a copy of a pooled encoder
+   * should not outlive it.
+   */
+  EncodingImpl(const EncodingImpl& other)
+    : m_buffer(other.m_buffer)
+    , m_begin(other.m_begin)
+    , m_end(other.m_end)
+    , m_isPooled(false)
+    , m_isBorrowingSlab(other.m_isBorrowingSlab)
   {
   }
 
+  EncodingImpl&
+  operator=(const EncodingImpl& other)
+  {
+    if (this != &other)
+      {
+        releaseToPool();
+        m_buffer = other.m_buffer;
+        m_begin = other.m_begin;
+        m_end = other.m_end;
+        m_isBorrowingSlab = other.m_isBorrowingSlab;
+      }
+    return *this;
+  }
+
+  ~EncodingImpl()
+  {
+    releaseToPool();
+  }
+
   inline size_t
   size() const;
 
@@ -160,6 +239,24 @@ public:
   // inline void
   // removeVarNumberFromBack(uint64_t varNumber);
 
+private:
+  /**
+   * @brief Take the free front part of the calling thread's current slab
+   * @param[in,out] freeSpace size hint of the encoding, or 0 if unknown; on return, number
+   *                of bytes at the front of the returned slab that can be used
+   */
+  static BufferPtr
+  acquireSlab(size_t& freeSpace);
+
+  /**
+   * @brief Give back a buffer whose first @p freeSpace bytes are unused
+   */
+  static void
+  releaseSlab(const BufferPtr& slab, size_t freeSpace);
+
+  inline void
+  releaseToPool();
+
 private:
   BufferPtr m_buffer;
 
@@ -168,6 +265,11 @@ private:
   // invariant: m_end always points to the position of next unwritten byte (if appending data)
   Buffer::iterator m_end;
 
+  // whether the destructor returns m_buffer to the pool
+  bool m_isPooled;
+  // whether bytes after m_end belong to other Blocks that share the slab
+  bool m_isBorrowingSlab;
+
   friend class Block;
 };
 
@@ -334,7 +436,21 @@ EncodingImpl<encoding::Buffer>::block(bool verifyLength/* = true*/) const
 inline void
 EncodingImpl<encoding::Buffer>::resize(size_t size, bool addInFront)
 {
-  if (addInFront)
+  if (m_isBorrowingSlab)
+    {
+      // only [m_begin, m_end) belongs to this encoder, so nothing else needs copying
+      size_t length = m_end - m_begin;
+
+      BufferPtr buf = make_shared<Buffer>(size);
+      Buffer::iterator begin = addInFront ? buf->end() - length : buf->begin();
+      std::copy(m_begin, m_end, begin);
+
+      m_buffer = buf;
+      m_begin = begin;
+      m_end = begin + length;
+      m_isBorrowingSlab = false;
+    }
+  else if (addInFront)
     {
       size_t diff_end = m_buffer->end() - m_end;
       size_t diff_begin = m_buffer->end() - m_begin;
@@ -362,6 +478,16 @@ EncodingImpl<encoding::Buffer>::resize(size_t size, bool addInFront)
     }
 }
 
+inline void
+EncodingImpl<encoding::Buffer>::releaseToPool()
+{
+  if (m_isPooled)
+    {
+      m_isPooled = false;
+      releaseSlab(m_buffer, m_begin - m_buffer->begin());
+    }
+}
+
 inline Buffer::iterator
 EncodingImpl<encoding::Buffer>::begin()
 {
@@ -535,7 +661,7 @@ EncodingImpl<encoding::Estimator>::prependBlock(const Block& block)
 inline size_t
 EncodingImpl<encoding::Buffer>::appendByte(uint8_t value)
 {
-  if (m_end == m_buffer->end())
+  if (m_end == m_buffer->end() || m_isBorrowingSlab)
     resize(m_buffer->size() * 2, false);
 
   *m_end = value;
@@ -552,7 +678,7 @@ EncodingImpl<encoding::Estimator>::appendByte(uint8_t value)
 inline size_t
 EncodingImpl<encoding::Buffer>::appendByteArray(const uint8_t* array, size_t length)
 {
-  if ((m_end + length) > m_buffer->end())
+  if ((m_end + length) > m_buffer->end() || m_isBorrowingSlab)
     resize(m_buffer->size() * 2 + length, false);
 
   std::copy(array, array + length, m_end);
@@ -23,6 +23,7 @@
 #define NDN_ENCODING_TLV_HPP
 
 #include <stdexcept>
+#include <cstring>
 #include <iostream>
 #include <iterator>
 #include <limits>
@@ -357,6 +358,57 @@ readVarNumber<std::istream_iterator<uint8_t>>(std::istream_iterator<uint8_t>& be
   return true;
 }
 
+/**
+ * @brief Read VAR-NUMBER from a contiguous buffer
+ *
+ * Specialization for raw pointers: the number of octets is checked once, and multi-octet
+ * numbers are read with a single copy, which does not require @p begin to be aligned.
+ */
+template<>
+inline bool
+readVarNumber<const uint8_t*>(const uint8_t*& begin, const uint8_t* const& end,
+                              uint64_t& value)
+{
+  if (begin == end)
+    return false;
+
+  uint8_t firstOctet = *begin;
+  if (firstOctet < 253)
+    {
+      value = firstOctet;
+      ++begin;
+      return true;
+    }
+
+  // 253, 254, and 255 are followed by 2, 4, and 8 octets respectively
+  size_t size = static_cast<size_t>(2) << (firstOctet - 253);
+  if (static_cast<size_t>(end - begin) <= size)
+    return false;
+  ++begin;
+
+  if (firstOctet == 253)
+    {
+      uint16_t number;
+      std::memcpy(&number, begin, sizeof(number));
+      value = be16toh(number);
+    }
+  else if (firstOctet == 254)
+    {
+      uint32_t number;
+      std::memcpy(&number, begin, sizeof(number));
+      value = be32toh(number);
+    }
+  else
+    {
+      uint64_t number;
+      std::memcpy(&number, begin, sizeof(number));
+      value = be64toh(number);
+    }
+
+  begin += size;
+  return true;
+}
+
 template<class InputIterator>
 inline uint32_t
 readType(InputIterator& begin, const InputIterator& end)
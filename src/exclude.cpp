@@ -24,6 +24,8 @@
 #include "exclude.hpp"
 #include "util/concepts.hpp"
 
+#include <algorithm>
+
 namespace ndn {
 
 BOOST_CONCEPT_ASSERT((boost::EqualityComparable<Exclude>));
@@ -111,10 +113,11 @@ Exclude::wireDecode(const Block& wire)
   // Exclude ::= EXCLUDE-TYPE TLV-LENGTH Any? (NameComponent (Any)?)+
   // Any     ::= ANY-TYPE TLV-LENGTH(=0)
 
+  // terms are collected in wire order, which is ascending in a well-formed filter
   Block::element_const_iterator i = m_wire.elements_begin();
   if (i->type() == tlv::Any)
     {
-      appendExclude(name::Component(), true);
+      m_exclude.push_back(std::make_pair(name::Component(), true));
       ++i;
     }
 
@@ -123,31 +126,66 @@ Exclude::wireDecode(const Block& wire)
       if (i->type() != tlv::NameComponent)
         throw Error("Incorrect format of Exclude filter");
 
-      name::Component excludedComponent(i->value(), i->value_size());
+      // the component refers to the wire encoding
+      name::Component excludedComponent(*i);
       ++i;
 
-      if (i != m_wire.elements_end())
-        {
-          if (i->type() == tlv::Any)
-            {
-              appendExclude(excludedComponent, true);
-              ++i;
-            }
-          else
-            {
-              appendExclude(excludedComponent, false);
-            }
-        }
-      else
-        {
-          appendExclude(excludedComponent, false);
-        }
+      bool any = i != m_wire.elements_end() && i->type() == tlv::Any;
+      if (any)
+        ++i;
+
+      m_exclude.push_back(std::make_pair(excludedComponent, any));
+    }
+
+  bool isAscending = true;
+  for (size_t j = 1; j < m_exclude.size() && isAscending; ++j)
+    isAscending = m_exclude[j - 1].first < m_exclude[j].first;
+
+  if (isAscending)
+    {
+      std::reverse(m_exclude.begin(), m_exclude.end());
+    }
+  else
+    {
+      exclude_type terms;
+      terms.swap(m_exclude);
+      for (exclude_type::const_iterator term = terms.begin(); term != terms.end(); ++term)
+        appendExclude(term->first, term->second);
+    }
+}
+
+void
+Exclude::appendExclude(const name::Component& name, bool any)
+{
+  size_t i = findLowerBound(name);
+  if (i != m_exclude.size() && m_exclude[i].first == name)
+    m_exclude[i].second = any;
+  else
+    m_exclude.insert(m_exclude.begin() + i, std::make_pair(name, any));
+}
+
+size_t
+Exclude::findLowerBound(const name::Component& comp) const
+{
+  if (m_exclude.empty())
+    return 0;
+
+  // binary search with a data-dependent select instead of a branch in every step
+  const exclude_type::value_type* base = &m_exclude.front();
+  size_t length = m_exclude.size();
+  while (length > 1)
+    {
+      size_t half = length / 2;
+      base = base[half - 1].first > comp ? base + half : base;
+      length -= half;
     }
+
+  return (base - &m_exclude.front()) + (base->first > comp ? 1 : 0);
 }
 
 // example: ANY /b /d ANY /f
 //
-// ordered in map as:
+// ordered as:
 //
 // /f (false); /d (true); /b (false); / (true)
 //
@@ -160,32 +198,75 @@ Exclude::wireDecode(const Block& wire)
 bool
 Exclude::isExcluded(const name::Component& comp) const
 {
-  const_iterator lowerBound = m_exclude.lower_bound(comp);
-  if (lowerBound == end())
+  size_t lowerBound = findLowerBound(comp);
+  if (lowerBound == m_exclude.size())
     return false;
 
-  if (lowerBound->second)
-    return true;
-  else
-    return lowerBound->first == comp;
-
-  return false;
+  return m_exclude[lowerBound].second || m_exclude[lowerBound].first == comp;
 }
 
 Exclude&
 Exclude::excludeOne(const name::Component& comp)
 {
-  if (!isExcluded(comp))
+  size_t lowerBound = findLowerBound(comp);
+  if (lowerBound == m_exclude.size() ||
+      (!m_exclude[lowerBound].second && m_exclude[lowerBound].first != comp))
     {
-      m_exclude.insert(std::make_pair(comp, false));
+      m_exclude.insert(m_exclude.begin() + lowerBound, std::make_pair(comp, false));
       m_wire.reset();
     }
   return *this;
 }
 
+Exclude&
+Exclude::excludeMany(std::vector<name::Component>& components)
+{
+  if (components.empty())
+    return *this;
+
+  std::sort(components.begin(), components.end(), std::greater<name::Component>());
+  components.erase(std::unique(components.begin(), components.end()), components.end());
+
+  // none of the components is excluded yet, so each one becomes a term without ANY and
+  // the existing terms are unaffected
+  exclude_type merged;
+  merged.reserve(m_exclude.size() + components.size());
+
+  exclude_type::const_iterator term = m_exclude.begin();
+  std::vector<name::Component>::const_iterator comp = components.begin();
+  while (term != m_exclude.end() || comp != components.end())
+    {
+      if (comp == components.end() || (term != m_exclude.end() && term->first > *comp))
+        merged.push_back(*term++);
+      else
+        merged.push_back(std::make_pair(*comp++, false));
+    }
+
+  m_exclude.swap(merged);
+  m_wire.reset();
+  return *this;
+}
+
+size_t
+Exclude::insertRangeStart(const name::Component& comp)
+{
+  size_t i = findLowerBound(comp);
+  if (i == m_exclude.size() || !m_exclude[i].second /*without ANY*/)
+    {
+      if (i != m_exclude.size() && m_exclude[i].first == comp)
+        m_exclude[i].second = true;
+      else
+        m_exclude.insert(m_exclude.begin() + i, std::make_pair(comp, true));
+    }
+  // else
+  // nothing special if start of the range already exists with ANY flag set
+
+  return i;
+}
+
 // example: ANY /b0 /d0 ANY /f0
 //
-// ordered in map as:
+// ordered as:
 //
 // /f0 (false); /d0 (true); /b0 (false); / (true)
 //
@@ -218,28 +299,21 @@ Exclude::excludeRange(const name::Component& from, const name::Component& to)
                 "(for single name exclude use Exclude::excludeOne)");
   }
 
-  iterator newFrom = m_exclude.lower_bound(from);
-  if (newFrom == end() || !newFrom->second /*without ANY*/) {
-    std::pair<iterator, bool> fromResult = m_exclude.insert(std::make_pair(from, true));
-    newFrom = fromResult.first;
-    if (!fromResult.second) {
-      // this means that the lower bound is equal to the item itself. So, just update ANY flag
-      newFrom->second = true;
-    }
-  }
-  // else
-  // nothing special if start of the range already exists with ANY flag set
+  size_t newFrom = insertRangeStart(from);
 
-  iterator newTo = m_exclude.lower_bound(to); // !newTo cannot be end()
-  if (newTo == newFrom || !newTo->second) {
-      std::pair<iterator, bool> toResult = m_exclude.insert(std::make_pair(to, false));
-      newTo = toResult.first;
-      ++ newTo;
+  size_t newTo = findLowerBound(to); // !newTo cannot be end()
+  if (newTo == newFrom || !m_exclude[newTo].second) {
+    if (m_exclude[newTo].first != to) {
+      m_exclude.insert(m_exclude.begin() + newTo, std::make_pair(to, false));
+      ++newFrom;
+    }
+    ++newTo;
   }
   // else
   // nothing to do really
 
-  m_exclude.erase(newTo, newFrom); // remove any intermediate node, since all of the are excluded
+  // remove any intermediate node, since all of the are excluded
+  m_exclude.erase(m_exclude.begin() + newTo, m_exclude.begin() + newFrom);
 
   m_wire.reset();
   return *this;
@@ -248,22 +322,10 @@ Exclude::excludeRange(const name::Component& from, const name::Component& to)
 Exclude&
 Exclude::excludeAfter(const name::Component& from)
 {
-  iterator newFrom = m_exclude.lower_bound(from);
-  if (newFrom == end() || !newFrom->second /*without ANY*/) {
-    std::pair<iterator, bool> fromResult = m_exclude.insert(std::make_pair(from, true));
-    newFrom = fromResult.first;
-    if (!fromResult.second) {
-      // this means that the lower bound is equal to the item itself. So, just update ANY flag
-      newFrom->second = true;
-    }
-  }
-  // else
-  // nothing special if start of the range already exists with ANY flag set
+  size_t newFrom = insertRangeStart(from);
 
-  if (newFrom != m_exclude.begin()) {
-    // remove any intermediate node, since all of the are excluded
-    m_exclude.erase(m_exclude.begin(), newFrom);
-  }
+  // remove any intermediate node, since all of the are excluded
+  m_exclude.erase(m_exclude.begin(), m_exclude.begin() + newFrom);
 
   m_wire.reset();
   return *this;
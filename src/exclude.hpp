@@ -28,7 +28,7 @@
 #include "encoding/encoding-buffer.hpp"
 
 #include <sstream>
-#include <map>
+#include <vector>
 
 namespace ndn {
 
@@ -100,6 +100,20 @@ public: // high-level API
   Exclude&
   excludeOne(const name::Component& comp);
 
+  /**
+   * @brief Exclude specific name components
+   *
+   * This is equivalent to calling excludeOne() for every component in [first, last), but
+   * the filter is rebuilt only once.
+   *
+   * @param first iterator to the first component to exclude
+   * @param last  iterator past the last component to exclude
+   * @returns *this to allow chaining
+   */
+  template<class Iterator>
+  Exclude&
+  excludeOne(Iterator first, Iterator last);
+
   /**
    * @brief Exclude components from range [from, to]
    * @param from first element of the range
@@ -145,7 +159,13 @@ public: // EqualityComparable concept
   operator!=(const Exclude& other) const;
 
 public: // low-level exclude element API
-  typedef std::map< name::Component, bool /*any*/, std::greater<name::Component> > exclude_type;
+  /**
+   * @brief Exclude terms, sorted in descending canonical order of the component
+   *
+   * The terms are kept in one contiguous array, and components decoded from the wire
+   * encoding refer to its buffer.
+   */
+  typedef std::vector< std::pair<name::Component, bool /*any*/> > exclude_type;
 
   typedef exclude_type::iterator iterator;
   typedef exclude_type::const_iterator const_iterator;
@@ -195,8 +215,26 @@ public: // low-level exclude element API
   rend() const;
 
 private:
+  /**
+   * @brief Find the first term whose component is not after @p comp in canonical order
+   * @return index of the term, or size() if there is none
+   */
+  size_t
+  findLowerBound(const name::Component& comp) const;
+
+  /**
+   * @brief Make the term of @p comp have ANY flag, inserting it if needed
+   * @return index of the term that excludes the range starting at @p comp
+   */
+  size_t
+  insertRangeStart(const name::Component& comp);
+
+  /**
+   * @brief Exclude components that are not excluded yet
+   * @param components the components, which are sorted in place
+   */
   Exclude&
-  excludeRange(iterator fromLowerBound, iterator toLowerBound);
+  excludeMany(std::vector<name::Component>& components);
 
 private:
   exclude_type m_exclude;
@@ -213,10 +251,18 @@ Exclude::excludeBefore(const name::Component& to)
   return excludeRange(name::Component(), to);
 }
 
-inline void
-Exclude::appendExclude(const name::Component& name, bool any)
+template<class Iterator>
+inline Exclude&
+Exclude::excludeOne(Iterator first, Iterator last)
 {
-  m_exclude[name] = any;
+  std::vector<name::Component> components;
+  for (; first != last; ++first)
+    {
+      if (!isExcluded(*first))
+        components.push_back(*first);
+    }
+
+  return excludeMany(components);
 }
 
 inline bool
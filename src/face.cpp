@@ -25,6 +25,8 @@
 #include "detail/face-impl.hpp"
 
 #include "encoding/tlv.hpp"
+#include "encoding/block-view.hpp"
+#include "name-view.hpp"
 #include "security/key-chain.hpp"
 #include "util/time.hpp"
 #include "util/random.hpp"
@@ -479,6 +481,30 @@ Face::fireProcessEventsTimeout(const boost::system::error_code& error)
 void
 Face::onReceiveElement(const Block& blockFromDaemon)
 {
+  // Peek at the packet type and name through views, so that packets nobody is waiting for
+  // are dropped without being decoded
+  BlockView packet(blockFromDaemon);
+  BlockView payload = packet;
+  if (packet.type() == tlv::nfd::LocalControlHeader) {
+    for (BlockView::const_iterator i = packet.elements_begin(); i != packet.elements_end(); ++i)
+      payload = *i;
+  }
+
+  if (payload.type() == tlv::Interest) {
+    if (m_impl->m_interestFilterTable.empty() ||
+        !m_impl->m_interestFilterTable.hasCandidates(NameView(payload.find(tlv::Name))))
+      return;
+  }
+  else if (payload.type() == tlv::Data) {
+    if (m_impl->m_pendingInterestTable.empty()) {
+      m_impl->m_pitTimeoutCheckTimer->cancel();
+      return;
+    }
+
+    if (!m_impl->m_pendingInterestTable.hasCandidates(NameView(payload.find(tlv::Name))))
+      return;
+  }
+
   const Block& block = nfd::LocalControlHeader::getPayload(blockFromDaemon);
 
   if (block.type() == tlv::Interest)
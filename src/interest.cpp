@@ -26,6 +26,7 @@
 #include "util/crypto.hpp"
 #include "util/concepts.hpp"
 #include "data.hpp"
+#include "detail/wire-check.hpp"
 
 namespace ndn {
 
@@ -289,10 +290,13 @@ Interest::wireEncode() const
   if (m_wire.hasWire())
     return m_wire;
 
+#ifdef NDN_CXX_HAVE_CXX_THREAD_LOCAL
+  EncodingBuffer buffer(encoding::Pooled);
+#else
+  // without a slab pool, size the buffer exactly
   EncodingEstimator estimator;
-  size_t estimatedSize = wireEncode(estimator);
-
-  EncodingBuffer buffer(estimatedSize, 0);
+  EncodingBuffer buffer(wireEncode(estimator), 0);
+#endif // NDN_CXX_HAVE_CXX_THREAD_LOCAL
   wireEncode(buffer);
 
   // to ensure that Nonce block points to the right memory location
@@ -320,14 +324,16 @@ Interest::wireDecode(const Block& wire)
   // Name
   m_name.wireDecode(m_wire.get(tlv::Name));
 
-  // Selectors
+  // Selectors are checked here but materialized on first access
+  m_selectors = Selectors();
   Block::element_const_iterator val = m_wire.find(tlv::Selectors);
   if (val != m_wire.elements_end())
     {
-      m_selectors.wireDecode(*val);
+      wire_check::checkSelectors(*val);
+      m_lazySelectors = *val;
     }
   else
-    m_selectors = Selectors();
+    m_lazySelectors = Block();
 
   // Nonce
   m_nonce = m_wire.get(tlv::Nonce);
@@ -353,6 +359,16 @@ Interest::wireDecode(const Block& wire)
     }
 }
 
+void
+Interest::decodeSelectors() const
+{
+  if (m_lazySelectors.empty())
+    return;
+
+  m_selectors.wireDecode(m_lazySelectors);
+  m_lazySelectors = Block();
+}
+
 std::ostream&
 operator<<(std::ostream& os, const Interest& interest)
 {
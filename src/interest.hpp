@@ -276,12 +276,14 @@ public: // Selectors
   bool
   hasSelectors() const
   {
-    return !m_selectors.empty();
+    return !getSelectors().empty();
   }
 
   const Selectors&
   getSelectors() const
   {
+    if (!m_lazySelectors.empty())
+      decodeSelectors();
     return m_selectors;
   }
 
@@ -289,6 +291,7 @@ public: // Selectors
   setSelectors(const Selectors& selectors)
   {
     m_selectors = selectors;
+    m_lazySelectors = Block();
     m_wire.reset();
     return *this;
   }
@@ -296,12 +299,13 @@ public: // Selectors
   int
   getMinSuffixComponents() const
   {
-    return m_selectors.getMinSuffixComponents();
+    return getSelectors().getMinSuffixComponents();
   }
 
   Interest&
   setMinSuffixComponents(int minSuffixComponents)
   {
+    decodeSelectors();
     m_selectors.setMinSuffixComponents(minSuffixComponents);
     m_wire.reset();
     return *this;
@@ -310,12 +314,13 @@ public: // Selectors
   int
   getMaxSuffixComponents() const
   {
-    return m_selectors.getMaxSuffixComponents();
+    return getSelectors().getMaxSuffixComponents();
   }
 
   Interest&
   setMaxSuffixComponents(int maxSuffixComponents)
   {
+    decodeSelectors();
     m_selectors.setMaxSuffixComponents(maxSuffixComponents);
     m_wire.reset();
     return *this;
@@ -324,12 +329,13 @@ public: // Selectors
   const KeyLocator&
   getPublisherPublicKeyLocator() const
   {
-    return m_selectors.getPublisherPublicKeyLocator();
+    return getSelectors().getPublisherPublicKeyLocator();
   }
 
   Interest&
   setPublisherPublicKeyLocator(const KeyLocator& keyLocator)
   {
+    decodeSelectors();
     m_selectors.setPublisherPublicKeyLocator(keyLocator);
     m_wire.reset();
     return *this;
@@ -338,12 +344,13 @@ public: // Selectors
   const Exclude&
   getExclude() const
   {
-    return m_selectors.getExclude();
+    return getSelectors().getExclude();
   }
 
   Interest&
   setExclude(const Exclude& exclude)
   {
+    decodeSelectors();
     m_selectors.setExclude(exclude);
     m_wire.reset();
     return *this;
@@ -352,12 +359,13 @@ public: // Selectors
   int
   getChildSelector() const
   {
-    return m_selectors.getChildSelector();
+    return getSelectors().getChildSelector();
   }
 
   Interest&
   setChildSelector(int childSelector)
   {
+    decodeSelectors();
     m_selectors.setChildSelector(childSelector);
     m_wire.reset();
     return *this;
@@ -366,12 +374,13 @@ public: // Selectors
   int
   getMustBeFresh() const
   {
-    return m_selectors.getMustBeFresh();
+    return getSelectors().getMustBeFresh();
   }
 
   Interest&
   setMustBeFresh(bool mustBeFresh)
   {
+    decodeSelectors();
     m_selectors.setMustBeFresh(mustBeFresh);
     m_wire.reset();
     return *this;
@@ -390,9 +399,17 @@ public: // EqualityComparable concept
     return !(*this == other);
   }
 
+private:
+  /**
+   * @brief Decode the Selectors element that wireDecode left in m_lazySelectors, if any
+   */
+  void
+  decodeSelectors() const;
+
 private:
   Name m_name;
-  Selectors m_selectors;
+  mutable Selectors m_selectors;
+  mutable Block m_lazySelectors; ///< Selectors element not decoded yet, if any
   mutable Block m_nonce;
   int m_scope;
   time::milliseconds m_interestLifetime;
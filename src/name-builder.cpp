@@ -0,0 +1,96 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2014 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "name-builder.hpp"
+
+namespace ndn {
+
+/**
+ * @brief Upper bound of the size of a name of @p prefixWire followed by one component
+ *        with @p valueSize octets of value
+ */
+static size_t
+getNameSizeBound(const Block& prefixWire, size_t valueSize)
+{
+  // a VAR-NUMBER takes at most 9 octets
+  size_t componentSize = 9 + tlv::sizeOfVarNumber(valueSize) + valueSize;
+  size_t valueLength = prefixWire.value_size() + componentSize;
+  return tlv::sizeOfVarNumber(tlv::Name) + tlv::sizeOfVarNumber(valueLength) + valueLength;
+}
+
+NameBuilder::NameBuilder(const Name& prefix)
+  : m_prefix(prefix)
+{
+  // encode once, so that every built name copies the same wire
+  m_prefix.wireEncode();
+}
+
+Name
+NameBuilder::append(const name::Component& component) const
+{
+  EncodingBuffer encoder(encoding::Pooled,
+                         getNameSizeBound(m_prefix.wireEncode(), component.value_size()));
+  size_t componentLength = prependByteArrayBlock(encoder, component.type(),
+                                                 component.value(), component.value_size());
+
+  return finishName(encoder, componentLength);
+}
+
+Name
+NameBuilder::appendNumber(uint64_t number) const
+{
+  EncodingBuffer encoder(encoding::Pooled,
+                         getNameSizeBound(m_prefix.wireEncode(), sizeof(uint64_t)));
+  size_t componentLength = prependNonNegativeIntegerBlock(encoder, tlv::NameComponent, number);
+
+  return finishName(encoder, componentLength);
+}
+
+Name
+NameBuilder::appendNumberWithMarker(uint8_t marker, uint64_t number) const
+{
+  EncodingBuffer encoder(encoding::Pooled,
+                         getNameSizeBound(m_prefix.wireEncode(), 1 + sizeof(uint64_t)));
+
+  size_t valueLength = encoder.prependNonNegativeInteger(number);
+  valueLength += encoder.prependByte(marker);
+  size_t componentLength = valueLength;
+  componentLength += encoder.prependVarNumber(valueLength);
+  componentLength += encoder.prependVarNumber(tlv::NameComponent);
+
+  return finishName(encoder, componentLength);
+}
+
+Name
+NameBuilder::finishName(EncodingBuffer& encoder, size_t componentLength) const
+{
+  const Block& prefixWire = m_prefix.wireEncode();
+
+  size_t totalLength = componentLength;
+  if (prefixWire.value_size() > 0)
+    totalLength += encoder.prependByteArray(prefixWire.value(), prefixWire.value_size());
+  totalLength += encoder.prependVarNumber(totalLength);
+  encoder.prependVarNumber(tlv::Name);
+
+  return Name(encoder.block());
+}
+
+} // namespace ndn
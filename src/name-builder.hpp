@@ -0,0 +1,107 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2014 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_NAME_BUILDER_HPP
+#define NDN_NAME_BUILDER_HPP
+
+#include "common.hpp"
+#include "name.hpp"
+#include "encoding/encoding-buffer.hpp"
+
+namespace ndn {
+
+/**
+ * @brief Creates names that extend a fixed prefix by one component
+ *
+ * This is meant for paths that build many names such as prefix/segment=N.  Compared to
+ * @code
+ *    Name(prefix).appendSegment(n)
+ * @endcode
+ * the new component is encoded in place instead of in its own buffer, and the resulting Name
+ * already has its wire encoding, which shares a pooled slab (see encoding::Pooled) with other
+ * encodings.  The only allocation is the component table of the resulting Name.
+ */
+class NameBuilder
+{
+public:
+  explicit
+  NameBuilder(const Name& prefix = Name());
+
+  const Name&
+  getPrefix() const
+  {
+    return m_prefix;
+  }
+
+  /**
+   * @brief Create a name of the prefix followed by @p component
+   */
+  Name
+  append(const name::Component& component) const;
+
+  /**
+   * @brief Create a name of the prefix followed by a nonNegativeInteger component
+   * @see Name::appendNumber
+   */
+  Name
+  appendNumber(uint64_t number) const;
+
+  /**
+   * @brief Create a name of the prefix followed by a marked nonNegativeInteger component
+   * @see Name::appendNumberWithMarker
+   */
+  Name
+  appendNumberWithMarker(uint8_t marker, uint64_t number) const;
+
+  /**
+   * @brief Create a name of the prefix followed by a version component
+   * @see Name::appendVersion
+   */
+  Name
+  appendVersion(uint64_t version) const
+  {
+    return appendNumberWithMarker(name::VERSION_MARKER, version);
+  }
+
+  /**
+   * @brief Create a name of the prefix followed by a segment number component
+   * @see Name::appendSegment
+   */
+  Name
+  appendSegment(uint64_t segmentNo) const
+  {
+    return appendNumberWithMarker(name::SEGMENT_MARKER, segmentNo);
+  }
+
+private:
+  /**
+   * @brief Prepend the prefix components and the Name header to a component in @p encoder
+   */
+  Name
+  finishName(EncodingBuffer& encoder, size_t componentLength) const;
+
+private:
+  Name m_prefix;
+};
+
+} // namespace ndn
+
+#endif // NDN_NAME_BUILDER_HPP
@@ -0,0 +1,153 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2014 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "name-view.hpp"
+
+#include <boost/functional/hash.hpp>
+
+namespace ndn {
+
+NameView::NameView()
+  : m_end(m_wire.value_end())
+{
+}
+
+NameView::NameView(const BlockView& wire)
+  : m_wire(wire)
+  , m_end(wire.value_end())
+{
+  if (m_wire.type() != tlv::Name)
+    throw tlv::Error("Unexpected TLV type when decoding Name");
+}
+
+NameView::NameView(const Name& name)
+  : m_wire(name.wireEncode())
+  , m_end(m_wire.value_end())
+{
+}
+
+size_t
+NameView::size() const
+{
+  size_t nComponents = 0;
+  for (const_iterator i = begin(); i != end(); ++i) {
+    ++nComponents;
+  }
+  return nComponents;
+}
+
+NameView
+NameView::getPrefix(size_t nComponents) const
+{
+  const_iterator i = begin();
+  for (; nComponents > 0 && i != end(); --nComponents) {
+    ++i;
+  }
+  return getPrefix(i);
+}
+
+bool
+NameView::isPrefixOf(const NameView& other) const
+{
+  // the same components may be encoded with different TLV-TYPE and TLV-LENGTH sizes,
+  // so bytes cannot be compared wholesale
+  const_iterator j = other.begin();
+  for (const_iterator i = begin(); i != end(); ++i, ++j) {
+    if (j == other.end() || compareComponents(*i, *j) != 0)
+      return false;
+  }
+  return true;
+}
+
+int
+NameView::compare(const NameView& other) const
+{
+  const_iterator i = begin();
+  const_iterator j = other.begin();
+  for (; i != end() && j != other.end(); ++i, ++j) {
+    int comparison = compareComponents(*i, *j);
+    if (comparison != 0)
+      return comparison;
+  }
+
+  if (i != end())
+    return 1;
+  else if (j != other.end())
+    return -1;
+  else
+    return 0;
+}
+
+size_t
+NameView::getHash() const
+{
+  size_t hash = 0;
+  for (const_iterator i = begin(); i != end(); ++i) {
+    hash = combineHash(hash, *i);
+  }
+  return hash;
+}
+
+size_t
+NameView::combineHash(size_t prefixHash, const BlockView& component)
+{
+  // same as Name::getPrefixHash
+  boost::hash_combine(prefixHash, component.type());
+  boost::hash_combine(prefixHash, boost::hash_range(component.value_begin(),
+                                                    component.value_end()));
+  return prefixHash;
+}
+
+Name
+NameView::toName() const
+{
+  if (m_end == m_wire.value_end())
+    return m_wire.empty() ? Name() : Name(m_wire.toBlock());
+
+  Name name;
+  for (const_iterator i = begin(); i != end(); ++i) {
+    name.append(name::Component(i->toBlock()));
+  }
+  return name;
+}
+
+int
+NameView::compareComponents(const BlockView& a, const BlockView& b)
+{
+  if (a.type() != b.type())
+    return a.type() < b.type() ? -1 : 1;
+
+  if (a.value_size() != b.value_size())
+    return a.value_size() < b.value_size() ? -1 : 1;
+
+  if (a.value_size() == 0)
+    return 0;
+
+  return std::memcmp(a.value(), b.value(), a.value_size());
+}
+
+std::ostream&
+operator<<(std::ostream& os, const NameView& name)
+{
+  return os << name.toName();
+}
+
+} // namespace ndn
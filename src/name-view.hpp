@@ -0,0 +1,232 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2014 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_NAME_VIEW_HPP
+#define NDN_NAME_VIEW_HPP
+
+#include "common.hpp"
+#include "name.hpp"
+#include "encoding/block-view.hpp"
+
+namespace ndn {
+
+/**
+ * @brief Non-owning view of a Name TLV element in a wire buffer, or of a prefix of it
+ *
+ * Components are exposed as BlockView and parsed on the fly, so comparing or prefix-matching
+ * names through views neither allocates nor touches reference counts.  Components are
+ * compared by TLV type and value, so names that differ only in the encoding of TLV-TYPE or
+ * TLV-LENGTH are equal.  The underlying buffer must outlive the view; toName() materializes
+ * an owning Name.
+ */
+class NameView
+{
+public:
+  typedef BlockView::const_iterator const_iterator;
+
+  /**
+   * @brief Create an empty view, which behaves as a name with no components
+   */
+  NameView();
+
+  /**
+   * @brief Create a view of the Name element @p wire
+   * @throw tlv::Error @p wire is not a Name element
+   */
+  explicit
+  NameView(const BlockView& wire);
+
+  /**
+   * @brief Create a view of the wire encoding of @p name
+   *
+   * @p name is encoded if it does not have wire encoding yet, and must not be modified while
+   * the view is in use.
+   */
+  explicit
+  NameView(const Name& name);
+
+  bool
+  empty() const
+  {
+    return m_end == m_wire.value_begin();
+  }
+
+  /**
+   * @brief Get the number of components
+   * @note The components are counted by walking the wire encoding.
+   */
+  size_t
+  size() const;
+
+  const_iterator
+  begin() const
+  {
+    return const_iterator(m_wire.value_begin(), m_end);
+  }
+
+  const_iterator
+  end() const
+  {
+    return const_iterator(m_end, m_end);
+  }
+
+  /**
+   * @brief Get the prefix made of the first @p nComponents components
+   *
+   * If the name has fewer components, the whole name is returned.
+   */
+  NameView
+  getPrefix(size_t nComponents) const;
+
+  /**
+   * @brief Get the prefix made of the components before @p position
+   * @param position an iterator of this view
+   */
+  NameView
+  getPrefix(const const_iterator& position) const
+  {
+    return NameView(m_wire, position->begin());
+  }
+
+  /**
+   * @brief Check if this name is a prefix of @p other
+   * @note Unlike Name::isPrefixOf, components of different TLV types never match.
+   */
+  bool
+  isPrefixOf(const NameView& other) const;
+
+  /**
+   * @brief Compare with @p other in NDN canonical order
+   * @return negative, zero or positive if this name is less than, equal to, or greater than
+   *         @p other, with the same ordering as Name::compare
+   */
+  int
+  compare(const NameView& other) const;
+
+  /**
+   * @brief Get hash value of this name, equal to toName().getHash()
+   */
+  size_t
+  getHash() const;
+
+  /**
+   * @brief Get hash value of a name made of a prefix with hash value @p prefixHash, followed
+   *        by @p component
+   *
+   * Hash values of successive prefixes can be computed this way while walking a name, the
+   * hash value of the empty name being zero.
+   */
+  static size_t
+  combineHash(size_t prefixHash, const BlockView& component);
+
+  /**
+   * @brief Create an owning Name holding a copy of the components
+   */
+  Name
+  toName() const;
+
+  bool
+  operator==(const NameView& other) const
+  {
+    return compare(other) == 0;
+  }
+
+  bool
+  operator!=(const NameView& other) const
+  {
+    return !(*this == other);
+  }
+
+  bool
+  operator<(const NameView& other) const
+  {
+    return compare(other) < 0;
+  }
+
+  /**
+   * @brief Compare two name components in NDN canonical order
+   */
+  static int
+  compareComponents(const BlockView& a, const BlockView& b);
+
+private:
+  NameView(const BlockView& wire, const uint8_t* end)
+    : m_wire(wire)
+    , m_end(end)
+  {
+  }
+
+private:
+  BlockView m_wire; ///< the whole Name element
+  const uint8_t* m_end; ///< end of the last component in the view
+};
+
+std::ostream&
+operator<<(std::ostream& os, const NameView& name);
+
+/**
+ * @brief NameView paired with its hash value, for use as a key of unordered containers
+ *
+ * The hash value is stored so that it can be computed incrementally for successive prefixes,
+ * or taken from Name::getPrefixHash.
+ */
+struct HashedNameView
+{
+  HashedNameView(const NameView& name, size_t hash)
+    : name(name)
+    , hash(hash)
+  {
+  }
+
+  explicit
+  HashedNameView(const NameView& name)
+    : name(name)
+    , hash(name.getHash())
+  {
+  }
+
+  bool
+  operator==(const HashedNameView& other) const
+  {
+    return hash == other.hash && name == other.name;
+  }
+
+  NameView name;
+  size_t hash;
+};
+
+} // namespace ndn
+
+namespace std {
+
+template<>
+struct hash<ndn::HashedNameView>
+{
+  size_t
+  operator()(const ndn::HashedNameView& name) const
+  {
+    return name.hash;
+  }
+};
+
+} // namespace std
+
+#endif // NDN_NAME_VIEW_HPP
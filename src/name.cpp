@@ -69,10 +69,13 @@ Name::wireEncode() const
   if (m_nameBlock.hasWire())
     return m_nameBlock;
 
+#ifdef NDN_CXX_HAVE_CXX_THREAD_LOCAL
+  EncodingBuffer buffer(encoding::Pooled);
+#else
+  // without a slab pool, size the buffer exactly
   EncodingEstimator estimator;
-  size_t estimatedSize = wireEncode(estimator);
-
-  EncodingBuffer buffer(estimatedSize, 0);
+  EncodingBuffer buffer(wireEncode(estimator), 0);
+#endif // NDN_CXX_HAVE_CXX_THREAD_LOCAL
   wireEncode(buffer);
 
   m_nameBlock = buffer.block();
@@ -89,6 +92,7 @@ Name::wireDecode(const Block& wire)
 
   m_nameBlock = wire;
   m_nameBlock.parse();
+  m_prefixHashes.clear();
 }
 
 void
@@ -282,7 +286,7 @@ Name::equals(const Name& name) const
     return false;
 
   for (size_t i = 0; i < size(); ++i) {
-    if (at(i) != name.at(i))
+    if (get(i) != name.get(i))
       return false;
   }
 
@@ -298,19 +302,56 @@ Name::isPrefixOf(const Name& name) const
 
   // Check if at least one of given components doesn't match.
   for (size_t i = 0; i < size(); ++i) {
-    if (at(i) != name.at(i))
+    if (get(i) != name.get(i))
       return false;
   }
 
   return true;
 }
 
+size_t
+Name::getPrefixHash(ssize_t nComponents) const
+{
+  size_t prefixSize = 0;
+  if (nComponents >= 0) {
+    prefixSize = std::min(static_cast<size_t>(nComponents), size());
+  }
+  else {
+    if (static_cast<size_t>(-nComponents) > size())
+      throw Error("Requested prefix does not exist (out of bounds)");
+    prefixSize = size() + nComponents;
+  }
+
+  if (m_prefixHashes.size() <= prefixSize) {
+    if (m_prefixHashes.empty())
+      m_prefixHashes.push_back(0); // empty name
+
+    m_prefixHashes.reserve(size() + 1);
+    size_t hash = m_prefixHashes.back();
+    for (size_t i = m_prefixHashes.size() - 1; i < size(); ++i) {
+      // NameView::combineHash must produce the same values
+      const Component& component = get(i);
+      boost::hash_combine(hash, component.type());
+      boost::hash_combine(hash, boost::hash_range(component.value_begin(),
+                                                  component.value_end()));
+      m_prefixHashes.push_back(hash);
+    }
+  }
+
+  return m_prefixHashes[prefixSize];
+}
 
 int
 Name::compare(const Name& other) const
 {
+  // a name is often compared with a copy of itself, e.g., in ordered containers
+  if (m_nameBlock.hasWire() && other.m_nameBlock.hasWire() &&
+      m_nameBlock.wire() == other.m_nameBlock.wire() &&
+      m_nameBlock.size() == other.m_nameBlock.size())
+    return 0;
+
   for (size_t i = 0; i < size() && i < other.size(); ++i) {
-    int comparison = at(i).compare(other.at(i));
+    int comparison = get(i).compare(other.get(i));
     if (comparison == 0)
       // The components at this index are equal, so check the next components.
       continue;
@@ -361,8 +402,7 @@ namespace std {
 size_t
 hash<ndn::Name>::operator()(const ndn::Name& name) const
 {
-  return boost::hash_range(name.wireEncode().wire(),
-                           name.wireEncode().wire() + name.wireEncode().size());
+  return name.getHash();
 }
 
 } // namespace std
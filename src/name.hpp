@@ -217,6 +217,7 @@ public:
   clear()
   {
     m_nameBlock = Block(tlv::Name);
+    m_prefixHashes.clear();
   }
 
   /**
@@ -388,6 +389,33 @@ public:
   bool
   isPrefixOf(const Name& name) const;
 
+  /**
+   * @brief Get hash value of this name
+   *
+   * Names that compare() as equal have equal hash values.  Component types are hashed,
+   * but equals() compares component values only, so names differing only in component
+   * types are equal yet may hash differently.  The value is computed together with the
+   * hash values of all prefixes on first use, and kept until the name is modified other
+   * than by appending components.
+   */
+  size_t
+  getHash() const
+  {
+    return getPrefixHash(size());
+  }
+
+  /**
+   * @brief Get hash value of a prefix of this name
+   *
+   * The result is equal to getPrefix(nComponents).getHash(), but no Name is created, and
+   * after the first call on an unmodified name, no component is hashed again.
+   *
+   * @param nComponents number of prefix components, with the same meaning as in getPrefix()
+   * @throws Error if -nComponents exceeds the number of components
+   */
+  size_t
+  getPrefixHash(ssize_t nComponents) const;
+
   //
   // vector equivalent interface.
   //
@@ -593,6 +621,10 @@ public:
 
 private:
   mutable Block m_nameBlock;
+
+  // m_prefixHashes[k] is the hash value of the first k components; components appended
+  // later are hashed on the next request
+  mutable std::vector<size_t> m_prefixHashes;
 };
 
 std::ostream&
@@ -152,6 +152,7 @@ KeyChain::initialize(const std::string& pib,
     tpmLocator = defaultTpmLocator;
 
   initializePib(pibLocator);
+  m_pib->onCertificatesChanged.connect(bind(&KeyChain::clearSigningInfoCache, this));
 
   std::string currentTpmLocator;
   try {
@@ -390,22 +391,15 @@ KeyChain::prepareUnsignedIdentityCertificate(const Name& keyName,
 Signature
 KeyChain::sign(const uint8_t* buffer, size_t bufferLength, const Name& certificateName)
 {
-  shared_ptr<IdentityCertificate> certificate = m_pib->getCertificate(certificateName);
-
-  KeyLocator keyLocator(certificate->getName().getPrefix(-1));
-  shared_ptr<Signature> sig =
-    determineSignatureWithPublicKey(keyLocator, certificate->getPublicKeyInfo().getKeyType());
-
-  if (!static_cast<bool>(sig))
-    throw SecTpm::Error("unknown key type");
-
+  const SigningInfo& signingInfo = getSigningInfo(certificateName);
+  Signature sig = *signingInfo.signature;
 
   // For temporary usage, we support SHA256 only, but will support more.
-  sig->setValue(m_tpm->signInTpm(buffer, bufferLength,
-                                 certificate->getPublicKeyName(),
-                                 DIGEST_ALGORITHM_SHA256));
+  sig.setValue(m_tpm->signInTpm(buffer, bufferLength,
+                                signingInfo.keyName,
+                                DIGEST_ALGORITHM_SHA256));
 
-  return *sig;
+  return sig;
 }
 
 shared_ptr<IdentityCertificate>
@@ -580,14 +574,80 @@ KeyChain::generateKeyPair(const Name& identityName, bool isKsk, const KeyParams&
   return keyName;
 }
 
+const KeyChain::SigningInfo&
+KeyChain::getSigningInfo(const Name& certificateName)
+{
+  std::map<Name, SigningInfo>::iterator it = m_signingInfoCache.find(certificateName);
+  if (it != m_signingInfoCache.end())
+    return it->second;
+
+  SigningInfo signingInfo = makeSigningInfo(*m_pib->getCertificate(certificateName));
+
+  // certificates are rarely rotated, so a full cache is simply started over
+  if (m_signingInfoCache.size() >= MAX_SIGNING_INFO_CACHE_SIZE)
+    m_signingInfoCache.clear();
+
+  return m_signingInfoCache.insert(std::make_pair(certificateName, signingInfo)).first->second;
+}
+
+const KeyChain::SigningInfo&
+KeyChain::getDefaultSigningInfo()
+{
+  // the PIB replaces its default certificate instance whenever the default changes
+  shared_ptr<IdentityCertificate> certificate = m_pib->getDefaultCertificate();
+  if (certificate != m_defaultSigningCertificate)
+    {
+      m_defaultSigningInfo = makeSigningInfo(*certificate);
+      m_defaultSigningCertificate = certificate;
+    }
+  return m_defaultSigningInfo;
+}
+
+KeyChain::SigningInfo
+KeyChain::makeSigningInfo(const IdentityCertificate& certificate)
+{
+  KeyLocator keyLocator(certificate.getName().getPrefix(-1));
+
+  SigningInfo signingInfo;
+  signingInfo.signature =
+    determineSignatureWithPublicKey(keyLocator, certificate.getPublicKeyInfo().getKeyType());
+
+  if (!static_cast<bool>(signingInfo.signature))
+    throw SecPublicInfo::Error("unknown key type!");
+
+  signingInfo.keyName = certificate.getPublicKeyName();
+  return signingInfo;
+}
+
+void
+KeyChain::clearSigningInfoCache()
+{
+  m_signingInfoCache.clear();
+  m_defaultSigningCertificate.reset();
+  m_defaultSigningInfo = SigningInfo();
+}
+
 void
 KeyChain::signPacketWrapper(Data& data, const Signature& signature,
                             const Name& keyName, DigestAlgorithm digestAlgorithm)
 {
   data.setSignature(signature);
 
-  EncodingBuffer encoder;
-  data.wireEncode(encoder, true);
+  // content from Data::allocateContent is not copied: the rest of the packet is encoded
+  // around it
+  EncodingBuffer encoder(0, 0);
+  if (!data.wireEncodeAroundContent(encoder))
+    {
+      EncodingEstimator estimator;
+      size_t unsignedPortionSize = data.wireEncode(estimator, true);
+
+      // the unsigned portion is encoded once, leaving room for the outer TLV header in front
+      // and for the SignatureValue at the back
+      encoder = EncodingBuffer(DATA_HEADER_RESERVE + unsignedPortionSize +
+                               SIGNATURE_VALUE_RESERVE,
+                               SIGNATURE_VALUE_RESERVE);
+      data.wireEncode(encoder, true);
+    }
 
   Block signatureValue = m_tpm->signInTpm(encoder.buf(), encoder.size(),
                                           keyName, digestAlgorithm);
@@ -732,15 +732,71 @@ private:
   signPacketWrapper(Interest& interest, const Signature& signature,
                     const Name& keyName, DigestAlgorithm digestAlgorithm);
 
+  /**
+   * @brief Signature template and key name derived from a signing certificate
+   */
+  struct SigningInfo
+  {
+    shared_ptr<Signature> signature;
+    Name keyName;
+  };
+
+  /**
+   * @brief Get the signing info of a certificate, decoding the certificate only on cache miss
+   *
+   * @throws SecPublicInfo::Error if the certificate does not exist or has an unknown key type
+   */
+  const SigningInfo&
+  getSigningInfo(const Name& certificateName);
+
+  /**
+   * @brief Get the signing info of the default certificate of the PIB
+   *
+   * The default certificate must have been set.
+   */
+  const SigningInfo&
+  getDefaultSigningInfo();
+
+  SigningInfo
+  makeSigningInfo(const IdentityCertificate& certificate);
+
+  /**
+   * @brief Drop all cached signing info
+   */
+  void
+  clearSigningInfoCache();
+
 public:
   static const Name DEFAULT_PREFIX;
   // RsaKeyParams is set to be default for backward compatibility.
   static const RsaKeyParams DEFAULT_KEY_PARAMS;
 
 private:
+  /**
+   * @brief Maximum number of certificates in the signing info cache
+   */
+  static const size_t MAX_SIGNING_INFO_CACHE_SIZE = 256;
+
+  /**
+   * @brief Room reserved for the TLV-TYPE and TLV-LENGTH of a Data packet being signed
+   */
+  static const size_t DATA_HEADER_RESERVE = 10;
+
+  /**
+   * @brief Room reserved for the SignatureValue of a Data packet being signed
+   *
+   * Fits the signature of an RSA key of up to 4096 bits; larger signatures still work,
+   * but cause the encoding to be reallocated.
+   */
+  static const size_t SIGNATURE_VALUE_RESERVE = 4 + 512;
+
   SecPublicInfo* m_pib;
   SecTpm* m_tpm;
   time::milliseconds m_lastTimestamp;
+
+  std::map<Name, SigningInfo> m_signingInfoCache;
+  shared_ptr<IdentityCertificate> m_defaultSigningCertificate;
+  SigningInfo m_defaultSigningInfo;
 };
 
 template<typename T>
@@ -750,15 +806,18 @@ KeyChain::sign(T& packet)
   if (!static_cast<bool>(m_pib->getDefaultCertificate()))
     setDefaultCertificateInternal();
 
-  sign(packet, *m_pib->getDefaultCertificate());
+  const SigningInfo& signingInfo = getDefaultSigningInfo();
+  signPacketWrapper(packet, *signingInfo.signature, signingInfo.keyName,
+                    DIGEST_ALGORITHM_SHA256);
 }
 
 template<typename T>
 void
 KeyChain::sign(T& packet, const Name& certificateName)
 {
-  shared_ptr<IdentityCertificate> certificate = m_pib->getCertificate(certificateName);
-  sign(packet, *certificate);
+  const SigningInfo& signingInfo = getSigningInfo(certificateName);
+  signPacketWrapper(packet, *signingInfo.signature, signingInfo.keyName,
+                    DIGEST_ALGORITHM_SHA256);
 }
 
 template<typename T>
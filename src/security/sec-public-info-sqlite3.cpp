@@ -211,6 +211,7 @@ SecPublicInfoSqlite3::setTpmLocator(const string& tpmLocator)
     return; // if the same, nothing will be changed
 
   setTpmLocatorInternal(tpmLocator, true); // set tpmInfo and reset pib
+  this->emitSignal(onCertificatesChanged, Name());
 }
 
 string
@@ -878,6 +879,7 @@ SecPublicInfoSqlite3::deleteCertificateInfo(const Name& certName)
   sqlite3_bind_string(stmt, 1, certName.toUri(), SQLITE_TRANSIENT);
   sqlite3_step(stmt);
   sqlite3_finalize(stmt);
+  this->emitSignal(onCertificatesChanged, certName);
 }
 
 void
@@ -905,6 +907,7 @@ SecPublicInfoSqlite3::deletePublicKeyInfo(const Name& keyName)
   sqlite3_bind_string(stmt, 2, keyId, SQLITE_TRANSIENT);
   sqlite3_step(stmt);
   sqlite3_finalize(stmt);
+  this->emitSignal(onCertificatesChanged, keyName);
 }
 
 void
@@ -927,6 +930,7 @@ SecPublicInfoSqlite3::deleteIdentityInfo(const Name& identityName)
   sqlite3_bind_string(stmt, 1, identity, SQLITE_TRANSIENT);
   sqlite3_step(stmt);
   sqlite3_finalize(stmt);
+  this->emitSignal(onCertificatesChanged, identityName);
 }
 
 std::string
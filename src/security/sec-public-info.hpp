@@ -26,6 +26,7 @@
 #include "security-common.hpp"
 #include "public-key.hpp"
 #include "identity-certificate.hpp"
+#include "../util/signal.hpp"
 
 
 namespace ndn {
@@ -450,6 +451,18 @@ public:
   void
   refreshDefaultCertificate();
 
+public:
+  /**
+   * @brief Signals that certificates have been removed from the storage
+   *
+   * The argument is the name of the deleted certificate, key, or identity.
+   * An empty name means that the whole storage has been reset.
+   */
+  util::Signal<SecPublicInfo, Name> onCertificatesChanged;
+
+protected:
+  DECLARE_SIGNAL_EMIT(onCertificatesChanged)
+
 protected:
   shared_ptr<IdentityCertificate> m_defaultCertificate;
   std::string m_location;
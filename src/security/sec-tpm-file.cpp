@@ -37,6 +37,8 @@
 #include <sys/stat.h>
 
 #include <algorithm>
+#include <list>
+#include <map>
 
 namespace ndn {
 
@@ -92,8 +94,173 @@ public:
     return keyFileName;
   }
 
+  /**
+   * @brief Private key decoded into a ready-to-use signer
+   */
+  struct SigningKey
+  {
+    KeyType keyType;
+    shared_ptr<CryptoPP::PK_Signer> signer;
+  };
+
+  /**
+   * @brief Get the signer for a private key, decoding the key file only when it is not cached
+   *
+   * The cached entry is reused only while the key file keeps the same identity (inode,
+   * size and modification time, with nanosecond precision where the platform provides it),
+   * so keys replaced by another process are re-read.  Keys written or deleted through this
+   * object drop their cached entry directly.
+   *
+   * @throw SecTpmFile::Error the private key does not exist or cannot be decoded
+   */
+  SigningKey
+  getSigningKey(const Name& keyName)
+  {
+    KeyCache::iterator it = m_keyCache.find(keyName);
+    string privateKeyFileName = (it != m_keyCache.end()) ?
+                                it->second.privateKeyFileName :
+                                transformName(keyName.toUri(), ".pri").string();
+
+    struct stat fileStatus;
+    if (::stat(privateKeyFileName.c_str(), &fileStatus) != 0)
+      {
+        invalidateKey(keyName);
+        throw Error("private key doesn't exists");
+      }
+
+    if (it != m_keyCache.end())
+      {
+        CachedKey& cached = it->second;
+        if (cached.inode == fileStatus.st_ino &&
+            cached.size == fileStatus.st_size &&
+            isSameTime(cached.lastWriteTime, getModificationTime(fileStatus)))
+          {
+            m_keyLru.splice(m_keyLru.end(), m_keyLru, cached.lruPosition);
+            return cached.key;
+          }
+        invalidateKey(keyName);
+      }
+
+    CachedKey cached;
+    cached.privateKeyFileName = privateKeyFileName;
+    cached.inode = fileStatus.st_ino;
+    cached.size = fileStatus.st_size;
+    cached.lastWriteTime = getModificationTime(fileStatus);
+    cached.key = loadSigningKey(keyName, privateKeyFileName);
+
+    if (m_keyCache.size() >= KEY_CACHE_CAPACITY)
+      {
+        m_keyCache.erase(m_keyLru.front());
+        m_keyLru.pop_front();
+      }
+    cached.lruPosition = m_keyLru.insert(m_keyLru.end(), keyName);
+    m_keyCache.insert(std::make_pair(keyName, cached));
+
+    return cached.key;
+  }
+
+  /**
+   * @brief Drop the cached signer of @p keyName, if any
+   */
+  void
+  invalidateKey(const Name& keyName)
+  {
+    KeyCache::iterator it = m_keyCache.find(keyName);
+    if (it == m_keyCache.end())
+      return;
+
+    m_keyLru.erase(it->second.lruPosition);
+    m_keyCache.erase(it);
+  }
+
+private:
+  static struct timespec
+  getModificationTime(const struct stat& fileStatus)
+  {
+#if defined(NDN_CXX_HAVE_STAT_ST_MTIM)
+    return fileStatus.st_mtim;
+#elif defined(NDN_CXX_HAVE_STAT_ST_MTIMESPEC)
+    return fileStatus.st_mtimespec;
+#else
+    struct timespec time;
+    time.tv_sec = fileStatus.st_mtime;
+    time.tv_nsec = 0;
+    return time;
+#endif
+  }
+
+  static bool
+  isSameTime(const struct timespec& a, const struct timespec& b)
+  {
+    return a.tv_sec == b.tv_sec && a.tv_nsec == b.tv_nsec;
+  }
+
+  SigningKey
+  loadSigningKey(const Name& keyName, const string& privateKeyFileName)
+  {
+    using namespace CryptoPP;
+
+    OBufferStream publicKeyOs;
+    FileSource(transformName(keyName.toUri(), ".pub").string().c_str(),
+               true,
+               new Base64Decoder(new FileSink(publicKeyOs)));
+    PublicKey publicKey(publicKeyOs.buf()->buf(), publicKeyOs.buf()->size());
+
+    ByteQueue bytes;
+    FileSource file(privateKeyFileName.c_str(), true, new Base64Decoder);
+    file.TransferTo(bytes);
+    bytes.MessageEnd();
+
+    SigningKey key;
+    key.keyType = publicKey.getKeyType();
+    switch (key.keyType)
+      {
+      case KEY_TYPE_RSA:
+        {
+          RSA::PrivateKey privateKey;
+          privateKey.Load(bytes);
+          key.signer = make_shared<RSASS<PKCS1v15, SHA256>::Signer>(privateKey);
+          break;
+        }
+      case KEY_TYPE_ECDSA:
+        {
+          ECDSA<ECP, SHA256>::PrivateKey privateKey;
+          privateKey.Load(bytes);
+          key.signer = make_shared<ECDSA<ECP, SHA256>::Signer>(privateKey);
+          break;
+        }
+      default:
+        throw Error("Unsupported key type!");
+      }
+    return key;
+  }
+
 public:
   boost::filesystem::path m_keystorePath;
+  CryptoPP::AutoSeededRandomPool m_rng;
+
+private:
+  /**
+   * @brief Maximum number of decoded private keys kept in memory
+   */
+  static const size_t KEY_CACHE_CAPACITY = 64;
+
+  typedef std::list<Name> KeyLru;
+
+  struct CachedKey
+  {
+    SigningKey key;
+    string privateKeyFileName;
+    ino_t inode;
+    off_t size;
+    struct timespec lastWriteTime;
+    KeyLru::iterator lruPosition;
+  };
+
+  typedef std::map<Name, CachedKey> KeyCache;
+
+  KeyCache m_keyCache;
+  KeyLru m_keyLru;
 };
 
 
@@ -119,6 +286,7 @@ SecTpmFile::generateKeyPairInTpm(const Name& keyName, const KeyParams& params)
     throw Error("private key exists");
 
   string keyFileName = m_impl->maintainMapping(keyURI);
+  m_impl->invalidateKey(keyName);
 
   try
     {
@@ -214,6 +382,8 @@ SecTpmFile::deleteKeyPairInTpm(const Name& keyName)
   boost::filesystem::path publicKeyPath(m_impl->transformName(keyName.toUri(), ".pub"));
   boost::filesystem::path privateKeyPath(m_impl->transformName(keyName.toUri(), ".pri"));
 
+  m_impl->invalidateKey(keyName);
+
   if (boost::filesystem::exists(publicKeyPath))
     boost::filesystem::remove(publicKeyPath);
 
@@ -269,6 +439,8 @@ SecTpmFile::importPrivateKeyPkcs8IntoTpm(const Name& keyName, const uint8_t* buf
     {
       using namespace CryptoPP;
 
+      m_impl->invalidateKey(keyName);
+
       string keyFileName = m_impl->maintainMapping(keyName.toUri());
       keyFileName.append(".pri");
       StringSource(buf, size,
@@ -289,6 +461,8 @@ SecTpmFile::importPublicKeyPkcs1IntoTpm(const Name& keyName, const uint8_t* buf,
     {
       using namespace CryptoPP;
 
+      m_impl->invalidateKey(keyName);
+
       string keyFileName = m_impl->maintainMapping(keyName.toUri());
       keyFileName.append(".pub");
       StringSource(buf, size,
@@ -306,86 +480,34 @@ Block
 SecTpmFile::signInTpm(const uint8_t* data, size_t dataLength,
                       const Name& keyName, DigestAlgorithm digestAlgorithm)
 {
-  string keyURI = keyName.toUri();
-
-  if (!doesKeyExistInTpm(keyName, KEY_CLASS_PRIVATE))
-    throw Error("private key doesn't exists");
+  if (digestAlgorithm != DIGEST_ALGORITHM_SHA256)
+    throw Error("Unsupported digest algorithm!");
 
   try
     {
       using namespace CryptoPP;
-      AutoSeededRandomPool rng;
 
-      //Read public key
-      shared_ptr<PublicKey> pubkeyPtr;
-      pubkeyPtr = getPublicKeyFromTpm(keyName);
+      Impl::SigningKey key = m_impl->getSigningKey(keyName);
 
-      switch (pubkeyPtr->getKeyType())
+      SecByteBlock signature(key.signer->MaxSignatureLength());
+      size_t signatureLength = key.signer->SignMessage(m_impl->m_rng, data, dataLength,
+                                                       signature);
+
+      switch (key.keyType)
         {
-          case KEY_TYPE_RSA:
-            {
-              //Read private key
-              ByteQueue bytes;
-              FileSource file(m_impl->transformName(keyURI, ".pri").string().c_str(),
-                              true, new Base64Decoder);
-              file.TransferTo(bytes);
-              bytes.MessageEnd();
-              RSA::PrivateKey privateKey;
-              privateKey.Load(bytes);
-
-              //Sign message
-              switch (digestAlgorithm)
-                {
-                case DIGEST_ALGORITHM_SHA256:
-                  {
-                    RSASS<PKCS1v15, SHA256>::Signer signer(privateKey);
-
-                    OBufferStream os;
-                    StringSource(data, dataLength,
-                                 true,
-                                 new SignerFilter(rng, signer, new FileSink(os)));
-
-                    return Block(tlv::SignatureValue, os.buf());
-                  }
-                default:
-                  throw Error("Unsupported digest algorithm!");
-                }
-            }
+        case KEY_TYPE_RSA:
+          return Block(tlv::SignatureValue,
+                       make_shared<Buffer>(signature.BytePtr(), signatureLength));
         case KEY_TYPE_ECDSA:
           {
-            //Read private key
-            ByteQueue bytes;
-            FileSource file(m_impl->transformName(keyURI, ".pri").string().c_str(),
-                            true, new Base64Decoder);
-            file.TransferTo(bytes);
-            bytes.MessageEnd();
-
-            //Sign message
-            switch (digestAlgorithm)
-              {
-              case DIGEST_ALGORITHM_SHA256:
-                {
-                  ECDSA<ECP, SHA256>::PrivateKey privateKey;
-                  privateKey.Load(bytes);
-                  ECDSA<ECP, SHA256>::Signer signer(privateKey);
-
-                  OBufferStream os;
-                  StringSource(data, dataLength,
-                               true,
-                               new SignerFilter(rng, signer, new FileSink(os)));
-
-                  uint8_t buf[200];
-                  size_t bufSize = DSAConvertSignatureFormat(buf, 200, DSA_DER,
-                                                             os.buf()->buf(), os.buf()->size(),
-                                                             DSA_P1363);
-
-                  shared_ptr<Buffer> sigBuffer = make_shared<Buffer>(buf, bufSize);
-
-                  return Block(tlv::SignatureValue, sigBuffer);
-                }
-              default:
-                throw Error("Unsupported digest algorithm!");
-              }
+            uint8_t buf[200];
+            size_t bufSize = DSAConvertSignatureFormat(buf, 200, DSA_DER,
+                                                       signature.BytePtr(), signatureLength,
+                                                       DSA_P1363);
+
+            shared_ptr<Buffer> sigBuffer = make_shared<Buffer>(buf, bufSize);
+
+            return Block(tlv::SignatureValue, sigBuffer);
           }
         default:
           throw Error("Unsupported key type!");
@@ -23,8 +23,10 @@
 #define NDN_TRANSPORT_STREAM_TRANSPORT_HPP
 
 #include "transport.hpp"
+#include "../encoding/block-decoder.hpp"
 
 #include <list>
+#include <vector>
 
 namespace ndn {
 
@@ -34,13 +36,42 @@ class StreamTransportImpl
 public:
   typedef StreamTransportImpl<BaseTransport,Protocol> Impl;
 
-  typedef std::list<Block> BlockSequence;
-  typedef std::list<BlockSequence> TransmissionQueue;
+  typedef std::vector<Block> BlockSequence;
+  typedef std::list<Block> TransmissionQueue;
+
+  /**
+   * @brief Size of a receive buffer chunk
+   *
+   * Received packets are delivered as Blocks that reference the chunk they were received
+   * into, so a chunk can be reused only after all such Blocks have been released.  A
+   * packet that does not fit into the rest of a chunk is copied into a buffer of its own.
+   */
+  static const size_t INPUT_CHUNK_SIZE = 4 * MAX_NDN_PACKET_SIZE;
+
+  /**
+   * @brief Maximum number of retired receive buffer chunks kept for reuse
+   */
+  static const size_t MAX_SPARE_INPUT_CHUNKS = 4;
+
+  /**
+   * @brief Maximum number of blocks coalesced into one gather write
+   */
+  static const size_t MAX_WRITE_BATCH_BLOCKS = 64;
+
+  /**
+   * @brief Maximum number of bytes coalesced into one gather write
+   *
+   * A single block larger than this limit is still written on its own.
+   */
+  static const size_t MAX_WRITE_BATCH_SIZE = 16 * MAX_NDN_PACKET_SIZE;
 
   StreamTransportImpl(BaseTransport& transport, boost::asio::io_service& ioService)
     : m_transport(transport)
     , m_socket(ioService)
-    , m_inputBufferSize(0)
+    , m_inputBuffer(make_shared<Buffer>(INPUT_CHUNK_SIZE))
+    , m_inputBufferEnd(0)
+    , m_decoder([this] (const Block& element) { m_transport.receive(element); })
+    , m_transmissionBatchSize(0)
     , m_connectionInProgress(false)
     , m_connectTimer(ioService)
   {
@@ -57,11 +88,7 @@ public:
         resume();
         m_transport.m_isConnected = true;
 
-        if (!m_transmissionQueue.empty()) {
-          boost::asio::async_write(m_socket, *m_transmissionQueue.begin(),
-                                   bind(&Impl::handleAsyncWrite, this, _1,
-                                        m_transmissionQueue.begin()));
-        }
+        asyncWrite();
       }
     else
       {
@@ -112,6 +139,8 @@ public:
     m_transport.m_isConnected = false;
     m_transport.m_isExpectingData = false;
     m_transmissionQueue.clear();
+    m_transmissionBatch.clear();
+    m_transport.resetSendQueueSize();
   }
 
   void
@@ -136,50 +165,41 @@ public:
     if (!m_transport.m_isExpectingData)
       {
         m_transport.m_isExpectingData = true;
-        m_inputBufferSize = 0;
-        m_socket.async_receive(boost::asio::buffer(m_inputBuffer, MAX_NDN_PACKET_SIZE), 0,
-                               bind(&Impl::handleAsyncReceive, this, _1, _2));
+
+        // discard any partially received packet
+        m_decoder.reset();
+        prepareInputBuffer();
+        asyncReceive();
       }
   }
 
   void
   send(const Block& wire)
   {
-    BlockSequence sequence;
-    sequence.push_back(wire);
-    m_transmissionQueue.push_back(sequence);
-
-    if (m_transport.m_isConnected && m_transmissionQueue.size() == 1) {
-      boost::asio::async_write(m_socket, *m_transmissionQueue.begin(),
-                               bind(&Impl::handleAsyncWrite, this, _1,
-                                    m_transmissionQueue.begin()));
-    }
+    enqueue(wire);
+
+    if (m_transport.m_isConnected && m_transmissionBatch.empty())
+      asyncWrite();
 
-    // if not connected or there is transmission in progress (m_transmissionQueue.size() > 1),
-    // next write will be scheduled either in connectHandler or in asyncWriteHandler
+    // if not connected or there is transmission in progress, next write will be scheduled
+    // either in connectHandler or in handleAsyncWrite
   }
 
   void
   send(const Block& header, const Block& payload)
   {
-    BlockSequence sequence;
-    sequence.push_back(header);
-    sequence.push_back(payload);
-    m_transmissionQueue.push_back(sequence);
-
-    if (m_transport.m_isConnected && m_transmissionQueue.size() == 1) {
-      boost::asio::async_write(m_socket, *m_transmissionQueue.begin(),
-                               bind(&Impl::handleAsyncWrite, this, _1,
-                                    m_transmissionQueue.begin()));
-    }
+    enqueue(header);
+    enqueue(payload);
+
+    if (m_transport.m_isConnected && m_transmissionBatch.empty())
+      asyncWrite();
 
-    // if not connected or there is transmission in progress (m_transmissionQueue.size() > 1),
-    // next write will be scheduled either in connectHandler or in asyncWriteHandler
+    // if not connected or there is transmission in progress, next write will be scheduled
+    // either in connectHandler or in handleAsyncWrite
   }
 
   void
-  handleAsyncWrite(const boost::system::error_code& error,
-                   TransmissionQueue::iterator queueItem)
+  handleAsyncWrite(const boost::system::error_code& error)
   {
     if (error)
       {
@@ -192,29 +212,10 @@ public:
         throw Transport::Error(error, "error while sending data to socket");
       }
 
-    m_transmissionQueue.erase(queueItem);
+    m_transport.updateSendQueueSize(m_transport.getSendQueueSize() - m_transmissionBatchSize);
+    m_transmissionBatch.clear();
 
-    if (!m_transmissionQueue.empty()) {
-      boost::asio::async_write(m_socket, *m_transmissionQueue.begin(),
-                               bind(&Impl::handleAsyncWrite, this, _1,
-                                    m_transmissionQueue.begin()));
-    }
-  }
-
-  bool
-  processAll(uint8_t* buffer, size_t& offset, size_t nBytesAvailable)
-  {
-    while (offset < nBytesAvailable)
-      {
-        Block element;
-        bool ok = Block::fromBuffer(buffer + offset, nBytesAvailable - offset, element);
-        if (!ok)
-          return false;
-
-        m_transport.receive(element);
-        offset += element.size();
-      }
-    return true;
+    asyncWrite();
   }
 
   void
@@ -231,50 +232,141 @@ public:
         throw Transport::Error(error, "error while receiving data from socket");
       }
 
-    m_inputBufferSize += nBytesRecvd;
-    // do magic
+    Buffer::const_iterator received = m_inputBuffer->begin() + m_inputBufferEnd;
+    m_inputBufferEnd += nBytesRecvd;
 
-    std::size_t offset = 0;
-    bool hasProcessedSome = processAll(m_inputBuffer, offset, m_inputBufferSize);
-    if (!hasProcessedSome && m_inputBufferSize == MAX_NDN_PACKET_SIZE && offset == 0)
+    // complete packets are delivered as Blocks referencing the input chunk, without copying;
+    // the decoder keeps the state of a partially received packet until the next receive
+    try
+      {
+        m_decoder.decode(m_inputBuffer, received, received + nBytesRecvd);
+      }
+    catch (const BlockDecoder::Error& e)
       {
         m_transport.close();
         throw Transport::Error(boost::system::error_code(),
-                               "input buffer full, but a valid TLV cannot be decoded");
+                               std::string("a valid TLV cannot be decoded: ") + e.what());
       }
 
-    if (offset > 0)
+    prepareInputBuffer();
+    asyncReceive();
+  }
+
+private:
+  void
+  enqueue(const Block& block)
+  {
+    m_transmissionQueue.push_back(block);
+    m_transport.updateSendQueueSize(m_transport.getSendQueueSize() + block.size());
+  }
+
+  /**
+   * @brief Write as many queued blocks as the batch limits allow with a single gather write
+   */
+  void
+  asyncWrite()
+  {
+    BOOST_ASSERT(m_transmissionBatch.empty());
+
+    m_transmissionBatchSize = 0;
+    while (!m_transmissionQueue.empty() &&
+           m_transmissionBatch.size() < MAX_WRITE_BATCH_BLOCKS)
       {
-        if (offset != m_inputBufferSize)
-          {
-            std::copy(m_inputBuffer + offset, m_inputBuffer + m_inputBufferSize,
-                      m_inputBuffer);
-            m_inputBufferSize -= offset;
-          }
-        else
+        size_t blockSize = m_transmissionQueue.front().size();
+        if (!m_transmissionBatch.empty() &&
+            m_transmissionBatchSize + blockSize > MAX_WRITE_BATCH_SIZE)
+          break;
+
+        m_transmissionBatch.push_back(m_transmissionQueue.front());
+        m_transmissionBatchSize += blockSize;
+        m_transmissionQueue.pop_front();
+      }
+
+    if (m_transmissionBatch.empty())
+      return;
+
+    boost::asio::async_write(m_socket, m_transmissionBatch,
+                             bind(&Impl::handleAsyncWrite, this, _1));
+  }
+
+  void
+  asyncReceive()
+  {
+    m_socket.async_receive(boost::asio::buffer(m_inputBuffer->get() + m_inputBufferEnd,
+                                               INPUT_CHUNK_SIZE - m_inputBufferEnd), 0,
+                           bind(&Impl::handleAsyncReceive, this, _1, _2));
+  }
+
+  /**
+   * @brief Make sure the current input chunk has room for a complete packet
+   *
+   * The chunk is rewound when neither a delivered Block nor the decoder references it
+   * anymore.  Otherwise, once a packet may no longer fit, receiving continues into another
+   * chunk; the decoder copies the bytes of a partially received packet on its own.
+   */
+  void
+  prepareInputBuffer()
+  {
+    if (m_inputBuffer.unique())
+      {
+        m_inputBufferEnd = 0;
+      }
+    else if (INPUT_CHUNK_SIZE - m_inputBufferEnd < MAX_NDN_PACKET_SIZE)
+      {
+        if (m_spareInputChunks.size() < MAX_SPARE_INPUT_CHUNKS)
+          m_spareInputChunks.push_back(m_inputBuffer);
+
+        m_inputBuffer = allocateInputChunk();
+        m_inputBufferEnd = 0;
+      }
+  }
+
+  BufferPtr
+  allocateInputChunk()
+  {
+    for (std::list<BufferPtr>::iterator i = m_spareInputChunks.begin();
+         i != m_spareInputChunks.end(); ++i)
+      {
+        if (i->unique())
           {
-            m_inputBufferSize = 0;
+            BufferPtr chunk = *i;
+            m_spareInputChunks.erase(i);
+            return chunk;
           }
       }
 
-    m_socket.async_receive(boost::asio::buffer(m_inputBuffer + m_inputBufferSize,
-                                               MAX_NDN_PACKET_SIZE - m_inputBufferSize), 0,
-                           bind(&Impl::handleAsyncReceive, this, _1, _2));
+    return make_shared<Buffer>(INPUT_CHUNK_SIZE);
   }
 
 protected:
   BaseTransport& m_transport;
 
   typename Protocol::socket m_socket;
-  uint8_t m_inputBuffer[MAX_NDN_PACKET_SIZE];
-  size_t m_inputBufferSize;
+  BufferPtr m_inputBuffer;
+  size_t m_inputBufferEnd; ///< offset past the last received byte
+  std::list<BufferPtr> m_spareInputChunks;
+  BlockDecoder m_decoder;
 
   TransmissionQueue m_transmissionQueue;
+  BlockSequence m_transmissionBatch; ///< blocks being written by the pending gather write
+  size_t m_transmissionBatchSize;
   bool m_connectionInProgress;
 
   boost::asio::deadline_timer m_connectTimer;
 };
 
+template<class BaseTransport, class Protocol>
+const size_t StreamTransportImpl<BaseTransport, Protocol>::INPUT_CHUNK_SIZE;
+
+template<class BaseTransport, class Protocol>
+const size_t StreamTransportImpl<BaseTransport, Protocol>::MAX_SPARE_INPUT_CHUNKS;
+
+template<class BaseTransport, class Protocol>
+const size_t StreamTransportImpl<BaseTransport, Protocol>::MAX_WRITE_BATCH_BLOCKS;
+
+template<class BaseTransport, class Protocol>
+const size_t StreamTransportImpl<BaseTransport, Protocol>::MAX_WRITE_BATCH_SIZE;
+
 
 template<class BaseTransport, class Protocol>
 class StreamTransportWithResolverImpl : public StreamTransportImpl<BaseTransport, Protocol>
@@ -24,6 +24,7 @@
 
 #include "../common.hpp"
 #include "../encoding/block.hpp"
+#include "../util/signal.hpp"
 
 #include <boost/asio.hpp>
 
@@ -42,6 +43,11 @@ public:
   typedef function<void (const Block& wire)> ReceiveCallback;
   typedef function<void ()> ErrorCallback;
 
+  /**
+   * @brief Default send queue high-water mark, in bytes
+   */
+  static const size_t DEFAULT_SEND_QUEUE_HIGH_WATER_MARK = 128 * MAX_NDN_PACKET_SIZE;
+
   inline
   Transport();
 
@@ -92,15 +98,71 @@ public:
   inline bool
   isExpectingData();
 
+  /**
+   * @brief Get the number of bytes queued for transmission but not yet written
+   */
+  inline size_t
+  getSendQueueSize() const;
+
+  inline size_t
+  getSendQueueHighWaterMark() const;
+
+  /**
+   * @brief Set the send queue size, in bytes, at which onSendQueueFull is emitted
+   */
+  inline void
+  setSendQueueHighWaterMark(size_t nBytes);
+
+  /**
+   * @brief Check whether the send queue is at or above the high-water mark
+   */
+  inline bool
+  isSendQueueFull() const;
+
+public:
+  /**
+   * @brief Emits when the send queue reaches the high-water mark
+   *
+   * Packets sent while the queue is full are still queued; the application is expected
+   * to hold off sending until onSendQueueDrained is emitted.
+   */
+  util::Signal<Transport> onSendQueueFull;
+
+  /**
+   * @brief Emits when the send queue drops below the high-water mark after being full
+   *
+   * It is not emitted when close() discards the queued packets.
+   */
+  util::Signal<Transport> onSendQueueDrained;
+
 protected:
   inline void
   receive(const Block& wire);
 
+  /**
+   * @brief Record a new send queue size and emit onSendQueueFull or onSendQueueDrained
+   *        if the high-water mark has been crossed
+   */
+  inline void
+  updateSendQueueSize(size_t nBytes);
+
+  /**
+   * @brief Forget the send queue after its packets have been discarded, without emitting
+   *        onSendQueueDrained
+   */
+  inline void
+  resetSendQueueSize();
+
 protected:
   boost::asio::io_service* m_ioService;
   bool m_isConnected;
   bool m_isExpectingData;
   ReceiveCallback m_receiveCallback;
+
+private:
+  size_t m_sendQueueSize;
+  size_t m_sendQueueHighWaterMark;
+  bool m_isSendQueueFull;
 };
 
 inline
@@ -108,6 +170,9 @@ Transport::Transport()
   : m_ioService(0)
   , m_isConnected(false)
   , m_isExpectingData(false)
+  , m_sendQueueSize(0)
+  , m_sendQueueHighWaterMark(DEFAULT_SEND_QUEUE_HIGH_WATER_MARK)
+  , m_isSendQueueFull(false)
 {
 }
 
@@ -148,12 +213,60 @@ Transport::isExpectingData()
   return m_isExpectingData;
 }
 
+inline size_t
+Transport::getSendQueueSize() const
+{
+  return m_sendQueueSize;
+}
+
+inline size_t
+Transport::getSendQueueHighWaterMark() const
+{
+  return m_sendQueueHighWaterMark;
+}
+
+inline void
+Transport::setSendQueueHighWaterMark(size_t nBytes)
+{
+  m_sendQueueHighWaterMark = nBytes;
+  updateSendQueueSize(m_sendQueueSize);
+}
+
+inline bool
+Transport::isSendQueueFull() const
+{
+  return m_isSendQueueFull;
+}
+
 inline void
 Transport::receive(const Block& wire)
 {
   m_receiveCallback(wire);
 }
 
+inline void
+Transport::updateSendQueueSize(size_t nBytes)
+{
+  m_sendQueueSize = nBytes;
+
+  bool isFull = m_sendQueueSize >= m_sendQueueHighWaterMark;
+  if (isFull == m_isSendQueueFull)
+    return;
+
+  m_isSendQueueFull = isFull;
+  if (isFull)
+    onSendQueueFull();
+  else
+    onSendQueueDrained();
+}
+
+inline void
+Transport::resetSendQueueSize()
+{
+  m_sendQueueSize = 0;
+  m_isSendQueueFull = false;
+}
+
 } // namespace ndn
 
 #endif // NDN_TRANSPORT_TRANSPORT_HPP
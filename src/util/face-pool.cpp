@@ -0,0 +1,145 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2014 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "face-pool.hpp"
+
+#include <boost/asio/io_service.hpp>
+
+namespace ndn {
+namespace util {
+
+FacePool::FacePool(size_t nShards)
+  : m_nextShard(0)
+{
+  BOOST_ASSERT(nShards > 0);
+
+  for (size_t i = 0; i < nShards; ++i) {
+    unique_ptr<Shard> shard(new Shard);
+    shard->ioService.reset(new boost::asio::io_service());
+    shard->face.reset(new Face(*shard->ioService));
+    m_shards.push_back(std::move(shard));
+  }
+}
+
+FacePool::FacePool(size_t nShards, const TransportFactory& makeTransport)
+  : m_nextShard(0)
+{
+  BOOST_ASSERT(nShards > 0);
+
+  for (size_t i = 0; i < nShards; ++i) {
+    unique_ptr<Shard> shard(new Shard);
+    shard->ioService.reset(new boost::asio::io_service());
+    shard->face.reset(new Face(makeTransport(), *shard->ioService));
+    m_shards.push_back(std::move(shard));
+  }
+}
+
+FacePool::~FacePool()
+{
+  try {
+    stop();
+  }
+  catch (...) {
+    // errors of the shards cannot be reported from the destructor
+  }
+}
+
+void
+FacePool::start()
+{
+  for (size_t i = 0; i < m_shards.size(); ++i) {
+    if (!m_shards[i]->thread.joinable())
+      m_shards[i]->thread = std::thread(bind(&FacePool::run, this, i));
+  }
+}
+
+void
+FacePool::stop()
+{
+  for (size_t i = 0; i < m_shards.size(); ++i) {
+    if (m_shards[i]->thread.joinable())
+      m_shards[i]->face->shutdown();
+  }
+
+  for (size_t i = 0; i < m_shards.size(); ++i) {
+    if (m_shards[i]->thread.joinable())
+      m_shards[i]->thread.join();
+  }
+
+  std::exception_ptr error;
+  {
+    std::lock_guard<std::mutex> lock(m_errorMutex);
+    error = m_error;
+    m_error = std::exception_ptr();
+  }
+  if (error)
+    std::rethrow_exception(error);
+}
+
+Face&
+FacePool::getFace(size_t shard)
+{
+  return *m_shards.at(shard)->face;
+}
+
+const PendingInterestId*
+FacePool::expressInterest(const Interest& interest, const OnData& onData,
+                          const OnTimeout& onTimeout)
+{
+  return nextFace().expressInterest(interest, onData, onTimeout);
+}
+
+void
+FacePool::removePendingInterest(const PendingInterestId* pendingInterestId)
+{
+  // removal is a no-op on shards that do not have the Interest
+  for (size_t i = 0; i < m_shards.size(); ++i) {
+    m_shards[i]->face->removePendingInterest(pendingInterestId);
+  }
+}
+
+void
+FacePool::put(const Data& data)
+{
+  nextFace().put(data);
+}
+
+Face&
+FacePool::nextFace()
+{
+  return *m_shards[m_nextShard.fetch_add(1, std::memory_order_relaxed) % m_shards.size()]->face;
+}
+
+void
+FacePool::run(size_t shard)
+{
+  try {
+    m_shards[shard]->face->processEvents(time::milliseconds::zero(), true);
+  }
+  catch (...) {
+    std::lock_guard<std::mutex> lock(m_errorMutex);
+    if (!m_error)
+      m_error = std::current_exception();
+  }
+}
+
+} // namespace util
+} // namespace ndn
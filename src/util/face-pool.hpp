@@ -0,0 +1,158 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2014 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_UTIL_FACE_POOL_HPP
+#define NDN_UTIL_FACE_POOL_HPP
+
+#include "../common.hpp"
+#include "../face.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+namespace ndn {
+namespace util {
+
+/**
+ * @brief A set of Faces, each running its own io_service on its own thread
+ *
+ * Every shard is a separate Face with its own forwarder connection, pending Interest table
+ * and Interest filter table, so shards never share state and need no locking.
+ * expressInterest, removePendingInterest and put can be called from any thread: the
+ * request is handed to a shard's io_service, and OnData / OnTimeout callbacks are invoked
+ * on that shard's thread.
+ *
+ * Interest filters and prefix registrations are per connection; they should be set up
+ * on each Face returned by getFace() that is expected to receive Interests.
+ *
+ * Example:
+ *
+ *     FacePool pool(4);
+ *     pool.start();
+ *     ...
+ *     // from any thread
+ *     pool.expressInterest(Interest("/example"), onData, onTimeout);
+ *     ...
+ *     pool.stop();
+ */
+class FacePool : noncopyable
+{
+public:
+  typedef function<shared_ptr<Transport>()> TransportFactory;
+
+  /**
+   * @brief Create @p nShards Faces connected using the transport from client.conf
+   */
+  explicit
+  FacePool(size_t nShards);
+
+  /**
+   * @brief Create @p nShards Faces, each connected using a transport from @p makeTransport
+   */
+  FacePool(size_t nShards, const TransportFactory& makeTransport);
+
+  /**
+   * @brief Stop all shards and wait for their threads to finish
+   */
+  ~FacePool();
+
+  /**
+   * @brief Start one thread per shard that processes events of the shard's Face
+   *
+   * Exceptions thrown while processing events terminate the affected shard's thread;
+   * the first such exception is rethrown by stop().
+   */
+  void
+  start();
+
+  /**
+   * @brief Shut down all Faces and wait for their threads to finish
+   */
+  void
+  stop();
+
+  size_t
+  size() const
+  {
+    return m_shards.size();
+  }
+
+  /**
+   * @brief Get the Face of the specified shard
+   *
+   * The Face is processed by the shard's thread once start() has been called, so only
+   * thread-safe Face methods may be called on it from other threads.
+   */
+  Face&
+  getFace(size_t shard);
+
+  /**
+   * @brief Express Interest on the next shard in round-robin order
+   *
+   * Safe to call from any thread.
+   */
+  const PendingInterestId*
+  expressInterest(const Interest& interest, const OnData& onData,
+                  const OnTimeout& onTimeout = OnTimeout());
+
+  /**
+   * @brief Cancel a pending Interest expressed through this pool
+   *
+   * Safe to call from any thread.
+   */
+  void
+  removePendingInterest(const PendingInterestId* pendingInterestId);
+
+  /**
+   * @brief Publish Data on the next shard in round-robin order
+   *
+   * Safe to call from any thread.
+   */
+  void
+  put(const Data& data);
+
+private:
+  Face&
+  nextFace();
+
+  void
+  run(size_t shard);
+
+private:
+  struct Shard
+  {
+    unique_ptr<boost::asio::io_service> ioService;
+    unique_ptr<Face> face;
+    std::thread thread;
+  };
+
+  std::vector<unique_ptr<Shard>> m_shards;
+  std::atomic<size_t> m_nextShard;
+
+  std::mutex m_errorMutex;
+  std::exception_ptr m_error;
+};
+
+} // namespace util
+} // namespace ndn
+
+#endif // NDN_UTIL_FACE_POOL_HPP
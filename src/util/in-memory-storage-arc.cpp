@@ -0,0 +1,140 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2014 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "in-memory-storage-arc.hpp"
+
+namespace ndn {
+namespace util {
+
+InMemoryStorageArc::InMemoryStorageArc(size_t limit)
+  : InMemoryStorage(limit)
+  , m_recencyTarget(0)
+{
+}
+
+InMemoryStorageArc::~InMemoryStorageArc()
+{
+}
+
+void
+InMemoryStorageArc::afterInsert(InMemoryStorageEntry* entry)
+{
+  BOOST_ASSERT(m_recent.size() + m_frequent.size() <= size());
+
+  GhostIndex::index<byFullName>::type& recentGhosts = m_recentGhosts.get<byFullName>();
+  GhostIndex::index<byFullName>::type& frequentGhosts = m_frequentGhosts.get<byFullName>();
+
+  // a hash collision only misdirects the adaptation of the target size
+  size_t hash = entry->getFullName().getHash();
+  GhostIndex::index<byFullName>::type::iterator recentGhost = recentGhosts.find(hash);
+  GhostIndex::index<byFullName>::type::iterator frequentGhost = frequentGhosts.find(hash);
+
+  if (recentGhost != recentGhosts.end()) {
+    // evicted too early from the recency list, so let it grow
+    size_t delta = std::max<size_t>(1, m_frequentGhosts.size() / m_recentGhosts.size());
+    m_recencyTarget = std::min(m_recencyTarget + delta, getCapacity());
+    recentGhosts.erase(recentGhost);
+    m_frequent.insert(entry);
+  }
+  else if (frequentGhost != frequentGhosts.end()) {
+    // evicted too early from the frequency list, so let it grow
+    size_t delta = std::max<size_t>(1, m_recentGhosts.size() / m_frequentGhosts.size());
+    m_recencyTarget = m_recencyTarget > delta ? m_recencyTarget - delta : 0;
+    frequentGhosts.erase(frequentGhost);
+    m_frequent.insert(entry);
+  }
+  else {
+    m_recent.insert(entry);
+  }
+
+  // ghosts are trimmed only after the lookup above, because the eviction that made room
+  // for this entry may have pushed the ghost of the same packet out of the bounds
+  trimGhosts();
+}
+
+bool
+InMemoryStorageArc::evictItem()
+{
+  if (!m_recent.empty() && (m_recent.size() > m_recencyTarget || m_frequent.empty())) {
+    evictFrom(m_recent, m_recentGhosts);
+    return true;
+  }
+
+  if (!m_frequent.empty()) {
+    evictFrom(m_frequent, m_frequentGhosts);
+    return true;
+  }
+
+  return false;
+}
+
+void
+InMemoryStorageArc::beforeErase(InMemoryStorageEntry* entry)
+{
+  if (m_recent.get<byEntity>().erase(entry) == 0)
+    m_frequent.get<byEntity>().erase(entry);
+}
+
+void
+InMemoryStorageArc::afterAccess(InMemoryStorageEntry* entry)
+{
+  CleanupIndex::index<byEntity>::type::iterator it = m_frequent.get<byEntity>().find(entry);
+  if (it != m_frequent.get<byEntity>().end()) {
+    CleanupIndex::index<byUsedTime>::type& usedTime = m_frequent.get<byUsedTime>();
+    usedTime.relocate(usedTime.end(), m_frequent.project<byUsedTime>(it));
+    return;
+  }
+
+  if (m_recent.get<byEntity>().erase(entry) > 0)
+    m_frequent.insert(entry);
+}
+
+void
+InMemoryStorageArc::evictFrom(CleanupIndex& list, GhostIndex& ghost)
+{
+  CleanupIndex::index<byUsedTime>::type::iterator it = list.get<byUsedTime>().begin();
+  InMemoryStorageEntry* entry = *it;
+  list.get<byUsedTime>().erase(it);
+
+  // remember the full name before the entry is released
+  ghost.get<byUsedTime>().push_back(entry->getFullName().getHash());
+  eraseImpl(entry->getFullName());
+}
+
+void
+InMemoryStorageArc::trimGhosts()
+{
+  size_t capacity = getCapacity();
+  m_recencyTarget = std::min(m_recencyTarget, capacity);
+
+  while (!m_recentGhosts.empty() && m_recent.size() + m_recentGhosts.size() > capacity) {
+    m_recentGhosts.get<byUsedTime>().pop_front();
+  }
+
+  while (!m_frequentGhosts.empty() &&
+         m_recent.size() + m_frequent.size() +
+         m_recentGhosts.size() + m_frequentGhosts.size() > 2 * capacity) {
+    m_frequentGhosts.get<byUsedTime>().pop_front();
+  }
+}
+
+} // namespace util
+} // namespace ndn
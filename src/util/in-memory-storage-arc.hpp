@@ -0,0 +1,162 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2014 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_UTIL_IN_MEMORY_STORAGE_ARC_HPP
+#define NDN_UTIL_IN_MEMORY_STORAGE_ARC_HPP
+
+#include "in-memory-storage.hpp"
+
+#include <boost/multi_index_container.hpp>
+#include <boost/multi_index/sequenced_index.hpp>
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/identity.hpp>
+
+namespace ndn {
+namespace util {
+
+/** @brief Provides in-memory storage employing Adaptive Replacement Cache (ARC) policy.
+ *
+ *  Entries that have been accessed once since insertion are kept in a recency list,
+ *  entries that have been accessed again are kept in a frequency list.  The hash values of
+ *  the full names of entries evicted from either list are remembered in a ghost list of the
+ *  same kind, so that no part of an evicted packet is kept alive, and
+ *  the reinsertion of a remembered packet shifts the target size of the recency list
+ *  toward the list that would have kept it.  A one-time scan therefore only displaces
+ *  entries of the recency list.
+ *  @sa Megiddo, N. and Modha, D. S. "ARC: A Self-Tuning, Low Overhead Replacement Cache",
+ *      FAST 2003
+ */
+class InMemoryStorageArc : public InMemoryStorage
+{
+public:
+  explicit
+  InMemoryStorageArc(size_t limit = 10);
+
+  virtual
+  ~InMemoryStorageArc();
+
+  /** @return{ current target size of the recency list, in packets }
+   */
+  size_t
+  getRecencyTarget() const
+  {
+    return m_recencyTarget;
+  }
+
+NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PROTECTED:
+  /** @brief Removes one Data packet from in-memory storage based on ARC, i.e. evict the least
+   *  recently used entry of the recency list if it exceeds its target size, otherwise the
+   *  least recently used entry of the frequency list
+   *  @return{ whether the Data was removed }
+   */
+  virtual bool
+  evictItem();
+
+  /** @brief Update the entry when the entry is returned by the find() function,
+   *  move it to the most recently used end of the frequency list
+   */
+  virtual void
+  afterAccess(InMemoryStorageEntry* entry);
+
+  /** @brief Update the entry after a entry is successfully inserted, add it to the recency
+   *  list, or to the frequency list and adapt the target size if it was remembered as evicted
+   */
+  virtual void
+  afterInsert(InMemoryStorageEntry* entry);
+
+  /** @brief Update the entry or other data structures before a entry is successfully erased,
+   *  erase it from the list it belongs to
+   */
+  virtual void
+  beforeErase(InMemoryStorageEntry* entry);
+
+private:
+  //multi_index_container to implement ARC lists
+  class byUsedTime;
+  class byEntity;
+
+  typedef boost::multi_index_container<
+    InMemoryStorageEntry*,
+    boost::multi_index::indexed_by<
+
+      // by Entry itself
+      boost::multi_index::hashed_unique<
+        boost::multi_index::tag<byEntity>,
+        boost::multi_index::identity<InMemoryStorageEntry*>
+      >,
+
+      // by last used time
+      boost::multi_index::sequenced<
+        boost::multi_index::tag<byUsedTime>
+      >
+
+    >
+  > CleanupIndex;
+
+  //multi_index_container to remember hash values of full names of evicted entries
+  class byFullName;
+
+  typedef boost::multi_index_container<
+    size_t,
+    boost::multi_index::indexed_by<
+
+      // by hash value of Name with implicit digest
+      boost::multi_index::hashed_unique<
+        boost::multi_index::tag<byFullName>,
+        boost::multi_index::identity<size_t>
+      >,
+
+      // by eviction time
+      boost::multi_index::sequenced<
+        boost::multi_index::tag<byUsedTime>
+      >
+
+    >
+  > GhostIndex;
+
+private:
+  /** @brief Evicts the least recently used entry of @p list and remembers it in @p ghost
+   */
+  void
+  evictFrom(CleanupIndex& list, GhostIndex& ghost);
+
+  /** @brief Keeps the ghost lists within the bounds of the current capacity
+   */
+  void
+  trimGhosts();
+
+private:
+  /// entries accessed once since insertion (T1)
+  CleanupIndex m_recent;
+  /// entries accessed more than once since insertion (T2)
+  CleanupIndex m_frequent;
+  /// hash values of full names recently evicted from m_recent (B1)
+  GhostIndex m_recentGhosts;
+  /// hash values of full names recently evicted from m_frequent (B2)
+  GhostIndex m_frequentGhosts;
+  /// target size of m_recent, adapted on ghost hits
+  size_t m_recencyTarget;
+};
+
+} // namespace util
+} // namespace ndn
+
+#endif // NDN_UTIL_IN_MEMORY_STORAGE_ARC_HPP
@@ -28,12 +28,37 @@ void
 InMemoryStorageEntry::release()
 {
   m_dataPacket.reset();
+  m_size = 0;
 }
 
 void
 InMemoryStorageEntry::setData(const Data& data)
 {
-  m_dataPacket = data.shared_from_this();
+  setData(data.shared_from_this(), computeStaleTime(data));
+}
+
+void
+InMemoryStorageEntry::setData(const shared_ptr<const Data>& data,
+                              const time::steady_clock::TimePoint& staleTime)
+{
+  m_dataPacket = data;
+  m_staleTime = staleTime;
+}
+
+void
+InMemoryStorageEntry::refreshStaleTime()
+{
+  m_staleTime = computeStaleTime(*m_dataPacket);
+}
+
+time::steady_clock::TimePoint
+InMemoryStorageEntry::computeStaleTime(const Data& data)
+{
+  const time::milliseconds& freshnessPeriod = data.getFreshnessPeriod();
+  if (freshnessPeriod >= time::milliseconds::zero())
+    return time::steady_clock::now() + freshnessPeriod;
+  else
+    return time::steady_clock::TimePoint::max();
 }
 
 } // namespace util
@@ -66,13 +66,76 @@ public:
   }
 
 
+  /** @brief Returns the time when the Data packet becomes stale
+   *
+   *  A Data packet without FreshnessPeriod never becomes stale.
+   */
+  const time::steady_clock::TimePoint&
+  getStaleTime() const
+  {
+    return m_staleTime;
+  }
+
+  /** @brief Checks if the Data packet is still fresh at @p now
+   */
+  bool
+  isFresh(const time::steady_clock::TimePoint& now) const
+  {
+    return m_staleTime > now;
+  }
+
+  /** @brief Returns the number of bytes counted for the entry by the byte budget of
+   *         InMemoryStorage
+   */
+  size_t
+  getSize() const
+  {
+    return m_size;
+  }
+
+  /** @brief Sets the number of bytes counted for the entry
+   *
+   *  The count is taken when the entry is inserted, so that the same count is released
+   *  when the entry is removed.
+   */
+  void
+  setSize(size_t size)
+  {
+    m_size = size;
+  }
+
   /** @brief Changes the content of in-memory storage entry
+   *
+   *  The Data packet is considered to have arrived now.
    */
   void
   setData(const Data& data);
 
+  /** @brief Changes the content of in-memory storage entry
+   *  @param staleTime the stale time of @p data, as from computeStaleTime()
+   *
+   *  This overload does not throw.
+   */
+  void
+  setData(const shared_ptr<const Data>& data, const time::steady_clock::TimePoint& staleTime);
+
+  /** @brief Restarts the freshness period of the Data packet as if it has arrived now
+   *
+   *  @note The stale time is a key of InMemoryStorage, so this must be called through
+   *        InMemoryStorage::Cache::modify() once the entry is in the storage.
+   */
+  void
+  refreshStaleTime();
+
+  /** @brief Returns the time when @p data becomes stale if it arrives now
+   */
+  static time::steady_clock::TimePoint
+  computeStaleTime(const Data& data);
+
 private:
   shared_ptr<const Data> m_dataPacket;
+  time::steady_clock::TimePoint m_staleTime;
+  size_t m_size;
 };
 
 } // namespace util
@@ -0,0 +1,240 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2014 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "in-memory-storage-tinylfu.hpp"
+
+namespace ndn {
+namespace util {
+
+const size_t InMemoryStorageTinyLfu::FrequencySketch::DEPTH;
+const uint8_t InMemoryStorageTinyLfu::FrequencySketch::MAX_COUNT;
+
+InMemoryStorageTinyLfu::FrequencySketch::FrequencySketch()
+  : m_widthMask(0)
+  , m_nAdditions(0)
+  , m_samplePeriod(0)
+{
+  ensureCapacity(0);
+}
+
+void
+InMemoryStorageTinyLfu::FrequencySketch::ensureCapacity(size_t capacity)
+{
+  size_t width = 16;
+  while (width < capacity && width <= std::numeric_limits<size_t>::max() / 2)
+    width *= 2;
+
+  if (width <= m_widthMask + 1)
+    return;
+
+  // width is even, so no byte is shared by two rows
+  m_table.assign(DEPTH * width / 2, 0);
+  m_widthMask = width - 1;
+  m_nAdditions = 0;
+  // the sketch is aged after about ten additions per counter of a row
+  m_samplePeriod = 10 * width;
+}
+
+size_t
+InMemoryStorageTinyLfu::FrequencySketch::getIndex(size_t hash, size_t row) const
+{
+  static const uint64_t SEEDS[DEPTH] = {
+    0xc3a5c85c97cb3127ULL, 0xb492b66fbe98f273ULL, 0x9ae16a3b2f90404fULL, 0xcbf29ce484222325ULL
+  };
+
+  // MurmurHash3 finalizer, so that every bit of the Name hash affects the column
+  uint64_t h = static_cast<uint64_t>(hash) + SEEDS[row];
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ULL;
+  h ^= h >> 33;
+  return row * (m_widthMask + 1) + (static_cast<size_t>(h) & m_widthMask);
+}
+
+void
+InMemoryStorageTinyLfu::FrequencySketch::increment(size_t hash)
+{
+  bool isAdded = false;
+  for (size_t row = 0; row < DEPTH; ++row) {
+    size_t index = getIndex(hash, row);
+    if (getCounter(index) < MAX_COUNT) {
+      m_table[index / 2] += 1 << getShift(index);
+      isAdded = true;
+    }
+  }
+
+  if (isAdded && ++m_nAdditions >= m_samplePeriod)
+    age();
+}
+
+uint8_t
+InMemoryStorageTinyLfu::FrequencySketch::estimate(size_t hash) const
+{
+  uint8_t count = MAX_COUNT;
+  for (size_t row = 0; row < DEPTH; ++row) {
+    count = std::min(count, getCounter(getIndex(hash, row)));
+  }
+  return count;
+}
+
+void
+InMemoryStorageTinyLfu::FrequencySketch::age()
+{
+  for (std::vector<uint8_t>::iterator it = m_table.begin(); it != m_table.end(); ++it) {
+    // the low bit of the high counter must not move into the low counter
+    *it = (*it >> 1) & 0x77;
+  }
+  m_nAdditions /= 2;
+}
+
+InMemoryStorageTinyLfu::InMemoryStorageTinyLfu(size_t limit)
+  : InMemoryStorage(limit)
+{
+}
+
+InMemoryStorageTinyLfu::~InMemoryStorageTinyLfu()
+{
+}
+
+size_t
+InMemoryStorageTinyLfu::getFrequency(const Name& fullName) const
+{
+  return m_sketch.estimate(std::hash<Name>()(fullName));
+}
+
+size_t
+InMemoryStorageTinyLfu::getHash(const InMemoryStorageEntry* entry)
+{
+  return std::hash<Name>()(entry->getFullName());
+}
+
+void
+InMemoryStorageTinyLfu::afterInsert(InMemoryStorageEntry* entry)
+{
+  BOOST_ASSERT(m_window.size() + m_probation.size() + m_protected.size() <= size());
+
+  m_sketch.ensureCapacity(getCapacity());
+  m_sketch.increment(getHash(entry));
+  m_window.insert(entry);
+}
+
+bool
+InMemoryStorageTinyLfu::evictItem()
+{
+  size_t capacity = getCapacity();
+  size_t windowCapacity = std::max<size_t>(1, capacity / 100);
+  size_t mainCapacity = capacity > windowCapacity ? capacity - windowCapacity : 0;
+
+  // Eviction happens before the new entry joins the window, so a full window already has
+  // a candidate to leave it.  While the main segment has room, candidates join it freely.
+  while (m_window.size() >= windowCapacity &&
+         m_probation.size() + m_protected.size() < mainCapacity) {
+    CleanupIndex::index<byUsedTime>::type::iterator it = m_window.get<byUsedTime>().begin();
+    m_probation.insert(*it);
+    m_window.get<byUsedTime>().erase(it);
+  }
+
+  CleanupIndex& victims = m_probation.empty() ? m_protected : m_probation;
+  bool hasCandidate = !m_window.empty() && (m_window.size() >= windowCapacity || victims.empty());
+
+  if (!hasCandidate) {
+    if (victims.empty())
+      return false;
+
+    evictFrom(victims);
+    return true;
+  }
+
+  if (victims.empty()) {
+    evictFrom(m_window);
+    return true;
+  }
+
+  // admit the window candidate into the main segment only if it is accessed more often
+  CleanupIndex::index<byUsedTime>::type::iterator candidate = m_window.get<byUsedTime>().begin();
+  InMemoryStorageEntry* victim = *victims.get<byUsedTime>().begin();
+  if (m_sketch.estimate(getHash(*candidate)) > m_sketch.estimate(getHash(victim))) {
+    evictFrom(victims);
+    m_probation.insert(*candidate);
+    m_window.get<byUsedTime>().erase(candidate);
+  }
+  else {
+    evictFrom(m_window);
+  }
+
+  return true;
+}
+
+void
+InMemoryStorageTinyLfu::beforeErase(InMemoryStorageEntry* entry)
+{
+  if (m_window.get<byEntity>().erase(entry) == 0 &&
+      m_probation.get<byEntity>().erase(entry) == 0)
+    m_protected.get<byEntity>().erase(entry);
+}
+
+void
+InMemoryStorageTinyLfu::afterAccess(InMemoryStorageEntry* entry)
+{
+  m_sketch.increment(getHash(entry));
+
+  CleanupIndex::index<byEntity>::type::iterator it = m_window.get<byEntity>().find(entry);
+  if (it != m_window.get<byEntity>().end()) {
+    CleanupIndex::index<byUsedTime>::type& usedTime = m_window.get<byUsedTime>();
+    usedTime.relocate(usedTime.end(), m_window.project<byUsedTime>(it));
+    return;
+  }
+
+  it = m_protected.get<byEntity>().find(entry);
+  if (it != m_protected.get<byEntity>().end()) {
+    CleanupIndex::index<byUsedTime>::type& usedTime = m_protected.get<byUsedTime>();
+    usedTime.relocate(usedTime.end(), m_protected.project<byUsedTime>(it));
+    return;
+  }
+
+  if (m_probation.get<byEntity>().erase(entry) == 0)
+    return;
+
+  m_protected.insert(entry);
+
+  // the protected list takes up to 80% of the main segment
+  size_t capacity = getCapacity();
+  size_t mainCapacity = capacity - std::min(capacity, std::max<size_t>(1, capacity / 100));
+  while (m_protected.size() > std::max<size_t>(1, mainCapacity * 4 / 5)) {
+    CleanupIndex::index<byUsedTime>::type::iterator demoted =
+      m_protected.get<byUsedTime>().begin();
+    m_probation.insert(*demoted);
+    m_protected.get<byUsedTime>().erase(demoted);
+  }
+}
+
+void
+InMemoryStorageTinyLfu::evictFrom(CleanupIndex& list)
+{
+  CleanupIndex::index<byUsedTime>::type::iterator it = list.get<byUsedTime>().begin();
+  InMemoryStorageEntry* entry = *it;
+  list.get<byUsedTime>().erase(it);
+  eraseImpl(entry->getFullName());
+}
+
+} // namespace util
+} // namespace ndn
@@ -0,0 +1,185 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2014 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_UTIL_IN_MEMORY_STORAGE_TINYLFU_HPP
+#define NDN_UTIL_IN_MEMORY_STORAGE_TINYLFU_HPP
+
+#include "in-memory-storage.hpp"
+
+#include <boost/multi_index_container.hpp>
+#include <boost/multi_index/sequenced_index.hpp>
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/identity.hpp>
+
+namespace ndn {
+namespace util {
+
+/** @brief Provides in-memory storage employing W-TinyLFU replacement policy.
+ *
+ *  New entries enter a small LRU window (1% of the capacity).  The least recently used
+ *  entry leaving the window competes with the eviction victim of the main segmented LRU
+ *  (probation and protected lists), and the one with the lower estimated access frequency
+ *  is evicted.  Frequencies are estimated by a Count-Min sketch whose counters are halved
+ *  periodically, so that formerly popular content ages out.
+ *  @sa Einziger, G., Friedman, R. and Manes, B. "TinyLFU: A Highly Efficient Cache Admission
+ *      Policy", ACM Transactions on Storage, 2017
+ */
+class InMemoryStorageTinyLfu : public InMemoryStorage
+{
+public:
+  explicit
+  InMemoryStorageTinyLfu(size_t limit = 10);
+
+  virtual
+  ~InMemoryStorageTinyLfu();
+
+  /** @return{ estimated number of recent accesses to the Data packet with @p fullName }
+   */
+  size_t
+  getFrequency(const Name& fullName) const;
+
+NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PROTECTED:
+  /** @brief Removes one Data packet from in-memory storage based on W-TinyLFU, i.e. evict the
+   *  less frequently accessed of the window candidate and the main victim
+   *  @return{ whether the Data was removed }
+   */
+  virtual bool
+  evictItem();
+
+  /** @brief Update the entry when the entry is returned by the find() function,
+   *  count the access and promote the entry from probation to protected
+   */
+  virtual void
+  afterAccess(InMemoryStorageEntry* entry);
+
+  /** @brief Update the entry after a entry is successfully inserted, count the access and
+   *  add it to the window
+   */
+  virtual void
+  afterInsert(InMemoryStorageEntry* entry);
+
+  /** @brief Update the entry or other data structures before a entry is successfully erased,
+   *  erase it from the list it belongs to
+   */
+  virtual void
+  beforeErase(InMemoryStorageEntry* entry);
+
+private:
+  /** @brief Count-Min sketch with 4-bit counters that are halved after a sample period
+   *
+   *  Two counters are packed into each byte of the table.
+   */
+  class FrequencySketch
+  {
+  public:
+    FrequencySketch();
+
+    /** @brief Resizes the sketch to suit @p capacity entries, if it is too small
+     *
+     *  Resizing discards the collected frequencies.
+     */
+    void
+    ensureCapacity(size_t capacity);
+
+    void
+    increment(size_t hash);
+
+    uint8_t
+    estimate(size_t hash) const;
+
+  private:
+    /** @return{ index of the counter of @p hash in @p row }
+     */
+    size_t
+    getIndex(size_t hash, size_t row) const;
+
+    uint8_t
+    getCounter(size_t index) const
+    {
+      return (m_table[index / 2] >> getShift(index)) & MAX_COUNT;
+    }
+
+    static size_t
+    getShift(size_t index)
+    {
+      return (index % 2) * 4;
+    }
+
+    /// halves all counters
+    void
+    age();
+
+  private:
+    static const size_t DEPTH = 4;
+    static const uint8_t MAX_COUNT = 15;
+
+    std::vector<uint8_t> m_table; ///< two counters per byte
+    size_t m_widthMask;
+    size_t m_nAdditions;
+    size_t m_samplePeriod;
+  };
+
+private:
+  //multi_index_container to implement the LRU lists
+  class byUsedTime;
+  class byEntity;
+
+  typedef boost::multi_index_container<
+    InMemoryStorageEntry*,
+    boost::multi_index::indexed_by<
+
+      // by Entry itself
+      boost::multi_index::hashed_unique<
+        boost::multi_index::tag<byEntity>,
+        boost::multi_index::identity<InMemoryStorageEntry*>
+      >,
+
+      // by last used time
+      boost::multi_index::sequenced<
+        boost::multi_index::tag<byUsedTime>
+      >
+
+    >
+  > CleanupIndex;
+
+private:
+  static size_t
+  getHash(const InMemoryStorageEntry* entry);
+
+  /** @brief Evicts the least recently used entry of @p list
+   */
+  void
+  evictFrom(CleanupIndex& list);
+
+private:
+  /// entries admitted recently
+  CleanupIndex m_window;
+  /// entries of the main segment that have not been accessed since leaving the window
+  CleanupIndex m_probation;
+  /// entries of the main segment that have been accessed since leaving the window
+  CleanupIndex m_protected;
+  FrequencySketch m_sketch;
+};
+
+} // namespace util
+} // namespace ndn
+
+#endif // NDN_UTIL_IN_MEMORY_STORAGE_TINYLFU_HPP
@@ -83,9 +83,15 @@ InMemoryStorage::const_iterator::operator!=(const const_iterator& rhs)
   return m_it != rhs.m_it;
 }
 
+const size_t InMemoryStorage::ENTRY_OVERHEAD = sizeof(InMemoryStorageEntry) + sizeof(Data) +
+                                               8 * sizeof(void*);
+
 InMemoryStorage::InMemoryStorage(size_t limit)
   : m_limit(limit)
   , m_nPackets(0)
+  , m_byteLimit(std::numeric_limits<size_t>::max())
+  , m_nBytes(0)
+  , m_isStaleFirstEviction(false)
 {
   // TODO consider a more suitable initial value
   m_capacity = 10;
@@ -150,9 +156,30 @@ InMemoryStorage::insert(const Data& data)
 {
   //check if identical Data/Name already exists
   Cache::index<byFullName>::type::iterator it = m_cache.get<byFullName>().find(data.getFullName());
-  if (it != m_cache.get<byFullName>().end())
+  if (it != m_cache.get<byFullName>().end()) {
+    // the packet has arrived again, so its freshness period starts over
+    m_cache.get<byFullName>().modify(it, [] (InMemoryStorageEntry* entry) {
+        entry->refreshStaleTime();
+      });
+    return;
+  }
+
+  size_t entrySize = getEntrySize(data);
+  if (entrySize > m_byteLimit)
     return;
 
+  // everything that can throw is done before the storage is modified
+  shared_ptr<const Data> dataPtr;
+  const Block& wire = data.wireEncode();
+  if (wire.getBuffer()->size() > wire.size()) {
+    // do not keep alive the rest of a receive buffer or an encoding slab
+    dataPtr = data.makeCompactCopy();
+  }
+  else {
+    dataPtr = data.shared_from_this();
+  }
+  time::steady_clock::TimePoint staleTime = InMemoryStorageEntry::computeStaleTime(data);
+
   //if full, double the capacity
   bool doesReachLimit = (getLimit() == getCapacity());
   if (isFull() && !doesReachLimit) {
@@ -162,8 +189,13 @@ InMemoryStorage::insert(const Data& data)
   }
 
   //if full and reach limitation of the capacity, employ replacement policy
+  time::steady_clock::TimePoint now = time::steady_clock::now();
   if (isFull() && doesReachLimit) {
-    evictItem();
+    evictOne(now);
+  }
+
+  //evict until the packet fits into the byte budget
+  while (m_nBytes + entrySize > m_byteLimit && evictOne(now)) {
   }
 
   //insert to cache
@@ -172,7 +204,9 @@ InMemoryStorage::insert(const Data& data)
   InMemoryStorageEntry* entry = m_freeEntries.top();
   m_freeEntries.pop();
   m_nPackets++;
-  entry->setData(data);
+  m_nBytes += entrySize;
+  entry->setData(dataPtr, staleTime);
+  entry->setSize(entrySize);
   m_cache.insert(entry);
 
   //let derived class do something with the entry
@@ -201,13 +235,28 @@ InMemoryStorage::find(const Name& name)
 shared_ptr<const Data>
 InMemoryStorage::find(const Interest& interest)
 {
+  time::steady_clock::TimePoint now = time::steady_clock::now();
+
+  //most Interests ask for an exact Data name, which the hashed index locates directly.
+  if (canSatisfyByExactName(interest)) {
+    InMemoryStorageEntry* ret = findByExactName(interest, now);
+    if (ret != 0) {
+      //let derived class do something with the entry
+      afterAccess(ret);
+      return ret->getData().shared_from_this();
+    }
+  }
+
   //if the interest contains implicit digest, it is possible to directly locate a packet.
   Cache::index<byFullName>::type::iterator it = m_cache.get<byFullName>()
                                                     .find(interest.getName());
 
   //if a packet is located by its full name, it must be the packet to return.
   if (it != m_cache.get<byFullName>().end()) {
-    return ((*it)->getData()).shared_from_this();
+    if (!interest.getMustBeFresh() || (*it)->isFresh(now))
+      return ((*it)->getData()).shared_from_this();
+    else
+      return shared_ptr<const Data>();
   }
 
   //if the packet is not discovered by last step, either the packet is not in the storage or
@@ -245,12 +294,15 @@ InMemoryStorage::selectChild(const Interest& interest,
       BOOST_ASSERT((*startingPoint)->getFullName() < interest.getName());
     }
 
+  // MustBeFresh is evaluated against the same time for all candidates
+  time::steady_clock::TimePoint now = time::steady_clock::now();
+
   bool hasLeftmostSelector = (interest.getChildSelector() <= 0);
   bool hasRightmostSelector = !hasLeftmostSelector;
 
   if (hasLeftmostSelector)
     {
-      if (interest.matchesData((*startingPoint)->getData()))
+      if (canSatisfy(interest, *startingPoint, now))
         {
           return *startingPoint;
         }
@@ -276,7 +328,7 @@ InMemoryStorage::selectChild(const Interest& interest,
 
           if (isInPrefix)
             {
-              if (interest.matchesData((*rightmostCandidate)->getData()))
+              if (canSatisfy(interest, *rightmostCandidate, now))
                 {
                   if (hasLeftmostSelector)
                     {
@@ -309,7 +361,7 @@ InMemoryStorage::selectChild(const Interest& interest,
 
   if (hasRightmostSelector) // if rightmost was not found, try starting point
     {
-      if (interest.matchesData((*startingPoint)->getData()))
+      if (canSatisfy(interest, *startingPoint, now))
         {
           return *startingPoint;
         }
@@ -318,14 +370,65 @@ InMemoryStorage::selectChild(const Interest& interest,
   return 0;
 }
 
+bool
+InMemoryStorage::canSatisfyByExactName(const Interest& interest)
+{
+  const Name& name = interest.getName();
+  if (name.empty() || name.get(-1).isImplicitSha256Digest())
+    return false;
+
+  const Selectors& selectors = interest.getSelectors();
+  return selectors.getMinSuffixComponents() <= 1 &&
+         (selectors.getMaxSuffixComponents() < 0 || selectors.getMaxSuffixComponents() >= 1) &&
+         selectors.getPublisherPublicKeyLocator().empty() &&
+         selectors.getExclude().empty() &&
+         selectors.getChildSelector() <= 0;
+}
+
+InMemoryStorageEntry*
+InMemoryStorage::findByExactName(const Interest& interest,
+                                 const time::steady_clock::TimePoint& now) const
+{
+  std::pair<Cache::index<byName>::type::const_iterator,
+            Cache::index<byName>::type::const_iterator> range =
+    m_cache.get<byName>().equal_range(interest.getName());
+
+  InMemoryStorageEntry* ret = 0;
+  for (Cache::index<byName>::type::const_iterator it = range.first; it != range.second; ++it) {
+    if (interest.getMustBeFresh() && !(*it)->isFresh(now))
+      continue;
+
+    if (ret == 0 || (*it)->getFullName() < ret->getFullName())
+      ret = *it;
+  }
+
+  return ret;
+}
+
+bool
+InMemoryStorage::canSatisfy(const Interest& interest, const InMemoryStorageEntry* entry,
+                            const time::steady_clock::TimePoint& now)
+{
+  if (interest.getMustBeFresh() && !entry->isFresh(now))
+    return false;
+
+  return interest.matchesData(entry->getData());
+}
+
 InMemoryStorage::Cache::iterator
 InMemoryStorage::freeEntry(Cache::iterator it)
 {
+  InMemoryStorageEntry* entry = *it;
+  m_nBytes -= entry->getSize();
+
+  //unlink the entry from the indexes while its Data, which provides the keys, is still set
+  it = m_cache.erase(it);
+
   //push the *empty* entry into mem pool
-  (*it)->release();
-  m_freeEntries.push(*it);
+  entry->release();
+  m_freeEntries.push(entry);
   m_nPackets--;
-  return m_cache.erase(it);
+  return it;
 }
 
 void
@@ -355,6 +458,57 @@ InMemoryStorage::erase(const Name& prefix, const bool isPrefix)
     setCapacity(getCapacity() / 2);
 }
 
+size_t
+InMemoryStorage::eraseStale()
+{
+  time::steady_clock::TimePoint now = time::steady_clock::now();
+
+  size_t nErased = 0;
+  while (evictStaleItem(now))
+    ++nErased;
+
+  return nErased;
+}
+
+bool
+InMemoryStorage::evictOne(const time::steady_clock::TimePoint& now)
+{
+  if (m_isStaleFirstEviction && evictStaleItem(now))
+    return true;
+
+  return evictItem();
+}
+
+size_t
+InMemoryStorage::getEntrySize(const Data& data)
+{
+  // insert() stores a compact copy of a packet whose buffer is larger than its wire encoding
+  return data.wireEncode().size() + ENTRY_OVERHEAD;
+}
+
+void
+InMemoryStorage::setByteLimit(size_t nMaxBytes)
+{
+  m_byteLimit = nMaxBytes;
+
+  time::steady_clock::TimePoint now = time::steady_clock::now();
+  while (m_nBytes > m_byteLimit && evictOne(now)) {
+  }
+}
+
+bool
+InMemoryStorage::evictStaleItem(const time::steady_clock::TimePoint& now)
+{
+  Cache::index<byStaleTime>::type& expiryIndex = m_cache.get<byStaleTime>();
+  if (expiryIndex.empty() || (*expiryIndex.begin())->isFresh(now))
+    return false;
+
+  //let derived class do something with the entry
+  beforeErase(*expiryIndex.begin());
+  freeEntry(m_cache.project<byFullName>(expiryIndex.begin()));
+  return true;
+}
+
 void
 InMemoryStorage::eraseImpl(const Name& name)
 {
@@ -31,6 +31,7 @@
 #include <boost/multi_index/member.hpp>
 #include <boost/multi_index_container.hpp>
 #include <boost/multi_index/ordered_index.hpp>
+#include <boost/multi_index/hashed_index.hpp>
 #include <boost/multi_index/sequenced_index.hpp>
 #include <boost/multi_index/identity.hpp>
 #include <boost/multi_index/mem_fun.hpp>
@@ -48,6 +49,8 @@ class InMemoryStorage : noncopyable
 public:
   //multi_index_container to implement storage
   class byFullName;
+  class byStaleTime;
+  class byName;
 
   typedef boost::multi_index_container<
     InMemoryStorageEntry*,
@@ -59,6 +62,22 @@ public:
         boost::multi_index::const_mem_fun<InMemoryStorageEntry, const Name&,
                                           &InMemoryStorageEntry::getFullName>,
         std::less<Name>
+      >,
+
+      // by the time the entry becomes stale (expiry index)
+      boost::multi_index::ordered_non_unique<
+        boost::multi_index::tag<byStaleTime>,
+        boost::multi_index::const_mem_fun<InMemoryStorageEntry,
+                                          const time::steady_clock::TimePoint&,
+                                          &InMemoryStorageEntry::getStaleTime>
+      >,
+
+      // by Name without implicit digest (exact-match lookup of selector-free Interests)
+      boost::multi_index::hashed_non_unique<
+        boost::multi_index::tag<byName>,
+        boost::multi_index::const_mem_fun<InMemoryStorageEntry, const Name&,
+                                          &InMemoryStorageEntry::getName>,
+        std::hash<Name>
       >
 
     >
@@ -109,6 +128,12 @@ public:
     }
   };
 
+  /** @brief Estimated memory used by an entry besides the wire encoding of its Data
+   *
+   *  It covers the entry, the Data object, and the nodes of the storage indexes.
+   */
+  static const size_t ENTRY_OVERHEAD;
+
   explicit
   InMemoryStorage(size_t limit = std::numeric_limits<size_t>::max());
 
@@ -122,7 +147,15 @@ public:
    *
    *  @note Packets are considered duplicate if the name with implicit digest matches.
    *  The new Data packet with the identical name, but a different payload
-   *  will be placed in the in-memory storage.
+   *  will be placed in the in-memory storage.  Inserting a duplicate restarts the
+   *  freshness period of the stored packet.
+   *
+   *  @note With a byte limit, entries are evicted until the packet fits; a packet larger
+   *  than the byte limit on its own is not inserted.
+   *
+   *  @note If the wire encoding of @p data is part of a larger buffer, a compact copy made
+   *  by Data::makeCompactCopy() is stored, and find() returns that copy.  Otherwise @p data
+   *  itself is stored, so it must be managed by shared_ptr.
    *
    *  @note It will invoke afterInsert(shared_ptr<InMemoryStorageEntry>).
    */
@@ -130,6 +163,9 @@ public:
   insert(const Data& data);
 
   /** @brief Finds the best match Data for an Interest
+   *
+   *  A stale Data packet, whose FreshnessPeriod has elapsed since its insertion, is not
+   *  returned for an Interest with MustBeFresh.
    *
    *  @note It will invoke afterAccess(shared_ptr<InMemoryStorageEntry>).
    *  As currently it is impossible to determine whether a Name contains implicit digest or not,
@@ -168,6 +204,34 @@ public:
   void
   erase(const Name& prefix, const bool isPrefix = true);
 
+  /** @brief Deletes all in-memory storage entries that are stale
+   *
+   *  @note It will invoke beforeErase(shared_ptr<InMemoryStorageEntry>).
+   *  @return{ number of deleted entries }
+   */
+  size_t
+  eraseStale();
+
+  /** @brief Enables or disables stale-first eviction
+   *
+   *  When enabled, a full in-memory storage evicts the entry that became stale earliest
+   *  before resorting to the replacement policy, so that memory goes to fresh content.
+   *  It is disabled by default.
+   */
+  void
+  setStaleFirstEviction(bool isEnabled)
+  {
+    m_isStaleFirstEviction = isEnabled;
+  }
+
+  /** @return{ whether stale-first eviction is enabled }
+   */
+  bool
+  getStaleFirstEviction() const
+  {
+    return m_isStaleFirstEviction;
+  }
+
   /** @return{ maximum number of packets that can be allowed to store in in-memory storage }
    */
   size_t
@@ -184,6 +248,33 @@ public:
     return m_nPackets;
   }
 
+  /** @brief Sets the byte budget of in-memory storage
+   *
+   *  The budget covers the wire encodings of the stored Data packets, plus ENTRY_OVERHEAD
+   *  per entry.  Packets are stored in buffers of their own size, see insert().  Entries are
+   *  evicted according to the replacement policy until the storage is within the budget, or
+   *  no entry can be evicted.
+   *  By default, the storage has no byte budget.
+   */
+  void
+  setByteLimit(size_t nMaxBytes);
+
+  /** @return{ maximum number of bytes that can be stored in in-memory storage }
+   */
+  size_t
+  getByteLimit() const
+  {
+    return m_byteLimit;
+  }
+
+  /** @return{ number of bytes stored in in-memory storage, as counted for the byte budget }
+   */
+  size_t
+  getNBytes() const
+  {
+    return m_nBytes;
+  }
+
   /** @brief Returns begin iterator of the in-memory storage ordering by
    *  name with digest
    *
@@ -275,6 +366,45 @@ NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   Cache::iterator
   freeEntry(Cache::iterator it);
 
+  /** @brief Removes the entry that became stale earliest, if it is stale at @p now
+   *  @return{ whether an entry was removed }
+   */
+  bool
+  evictStaleItem(const time::steady_clock::TimePoint& now);
+
+  /** @brief Removes one entry, a stale one first if stale-first eviction is enabled
+   *  @return{ whether an entry was removed }
+   */
+  bool
+  evictOne(const time::steady_clock::TimePoint& now);
+
+  /** @return{ number of bytes of @p data counted for the byte budget }
+   */
+  static size_t
+  getEntrySize(const Data& data);
+
+  /** @brief Checks if the selectors of @p interest let a Data packet named exactly as
+   *  the Interest be the answer whenever one exists
+   */
+  static bool
+  canSatisfyByExactName(const Interest& interest);
+
+  /** @brief Finds the leftmost entry named exactly as @p interest using the hashed index
+   *
+   *  The implicit digest sorts before any other component, so if there is a Data packet
+   *  named exactly as the Interest, the entry with the least full name among such packets
+   *  is what selectChild would return for an Interest accepted by canSatisfyByExactName.
+   *  @return{ the match, if any; otherwise 0 }
+   */
+  InMemoryStorageEntry*
+  findByExactName(const Interest& interest, const time::steady_clock::TimePoint& now) const;
+
+  /** @brief Checks if @p entry satisfies @p interest, including MustBeFresh at @p now
+   */
+  static bool
+  canSatisfy(const Interest& interest, const InMemoryStorageEntry* entry,
+             const time::steady_clock::TimePoint& now);
+
   /** @brief Implements child selector (leftmost, rightmost, undeclared).
    *  Operates on the first layer of a skip list.
    *
@@ -301,8 +431,14 @@ private:
   size_t m_capacity;
   /// current number of packets in in-memory storage
   size_t m_nPackets;
+  /// user defined maximum number of bytes in in-memory storage
+  size_t m_byteLimit;
+  /// current number of bytes in in-memory storage
+  size_t m_nBytes;
   /// memory pool
   std::stack<InMemoryStorageEntry*> m_freeEntries;
+  /// whether stale entries are evicted before applying the replacement policy
+  bool m_isStaleFirstEviction;
 };
 
 } // namespace util
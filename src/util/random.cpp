@@ -27,6 +27,8 @@
 #include <boost/random/mersenne_twister.hpp>
 #include <boost/random/uniform_int_distribution.hpp>
 
+#include <mutex>
+
 #include "../security/cryptopp.hpp"
 
 namespace ndn {
@@ -59,6 +61,37 @@ generateSecureWord64()
 }
 
 // Boost.Random-based (simple) random generators
+//
+// Each thread has its own generator when thread_local is available, so that threads such as
+// those of FacePool can generate Interest nonces concurrently; otherwise a mutex guards the
+// shared generator.
+
+#ifdef NDN_CXX_HAVE_CXX_THREAD_LOCAL
+
+static boost::random::mt19937&
+getRandomGenerator()
+{
+  thread_local boost::random_device randomSeedGenerator;
+  thread_local boost::random::mt19937 gen(randomSeedGenerator);
+
+  return gen;
+}
+
+uint32_t
+generateWord32()
+{
+  boost::random::uniform_int_distribution<uint32_t> distribution;
+  return distribution(getRandomGenerator());
+}
+
+uint64_t
+generateWord64()
+{
+  boost::random::uniform_int_distribution<uint64_t> distribution;
+  return distribution(getRandomGenerator());
+}
+
+#else
 
 static boost::random::mt19937&
 getRandomGenerator()
@@ -69,20 +102,26 @@ getRandomGenerator()
   return gen;
 }
 
+static std::mutex g_randomGeneratorMutex;
+
 uint32_t
 generateWord32()
 {
-  static boost::random::uniform_int_distribution<uint32_t> distribution;
+  boost::random::uniform_int_distribution<uint32_t> distribution;
+  std::lock_guard<std::mutex> lock(g_randomGeneratorMutex);
   return distribution(getRandomGenerator());
 }
 
 uint64_t
 generateWord64()
 {
-  static boost::random::uniform_int_distribution<uint64_t> distribution;
+  boost::random::uniform_int_distribution<uint64_t> distribution;
+  std::lock_guard<std::mutex> lock(g_randomGeneratorMutex);
   return distribution(getRandomGenerator());
 }
 
+#endif // NDN_CXX_HAVE_CXX_THREAD_LOCAL
+
 
 } // namespace random
 } // namespace ndn
@@ -25,10 +25,319 @@
 
 namespace ndn {
 
+namespace {
+
+/**
+ * \brief Free list of equally sized memory blocks that grows in chunks
+ *
+ * The block size is set by the first allocation; larger requests go to the global heap.
+ * Blocks are never returned to the system until the pool is destroyed.
+ */
+class BlockPool : noncopyable
+{
+public:
+  BlockPool()
+    : m_blockSize(0)
+    , m_freeBlocks(0)
+  {
+  }
+
+  void*
+  allocate(size_t size)
+  {
+    if (m_blockSize == 0)
+      m_blockSize = (size + sizeof(Block) - 1) / sizeof(Block);
+
+    if (size > m_blockSize * sizeof(Block))
+      return ::operator new(size);
+
+    if (m_freeBlocks == 0) {
+      m_chunks.push_back(unique_ptr<Block[]>(new Block[m_blockSize * CHUNK_SIZE]));
+      Block* chunk = m_chunks.back().get();
+      for (size_t i = 0; i < CHUNK_SIZE; ++i) {
+        chunk[i * m_blockSize].next = m_freeBlocks;
+        m_freeBlocks = &chunk[i * m_blockSize];
+      }
+    }
+
+    Block* block = m_freeBlocks;
+    m_freeBlocks = block->next;
+    return block;
+  }
+
+  void
+  deallocate(void* p, size_t size)
+  {
+    if (size > m_blockSize * sizeof(Block)) {
+      ::operator delete(p);
+      return;
+    }
+
+    Block* block = static_cast<Block*>(p);
+    block->next = m_freeBlocks;
+    m_freeBlocks = block;
+  }
+
+private:
+  union Block
+  {
+    Block* next;
+    long double alignLongDouble;
+    uint64_t alignInteger;
+  };
+
+  static const size_t CHUNK_SIZE = 256;
+
+  size_t m_blockSize; ///< in units of Block
+  std::vector<unique_ptr<Block[]>> m_chunks;
+  Block* m_freeBlocks;
+};
+
+/**
+ * \brief Allocator that takes memory from a shared BlockPool
+ *
+ * Every copy keeps the pool alive, so objects allocated through it may outlive the owner
+ * of the pool.
+ */
+template<typename T>
+class PoolAllocator
+{
+public:
+  typedef T value_type;
+
+  explicit
+  PoolAllocator(const shared_ptr<BlockPool>& pool)
+    : m_pool(pool)
+  {
+  }
+
+  template<typename U>
+  PoolAllocator(const PoolAllocator<U>& other)
+    : m_pool(other.m_pool)
+  {
+  }
+
+  T*
+  allocate(size_t n)
+  {
+    return static_cast<T*>(m_pool->allocate(n * sizeof(T)));
+  }
+
+  void
+  deallocate(T* p, size_t n)
+  {
+    m_pool->deallocate(p, n * sizeof(T));
+  }
+
+  template<typename U>
+  bool
+  operator==(const PoolAllocator<U>& other) const
+  {
+    return m_pool == other.m_pool;
+  }
+
+  template<typename U>
+  bool
+  operator!=(const PoolAllocator<U>& other) const
+  {
+    return m_pool != other.m_pool;
+  }
+
+private:
+  template<typename U>
+  friend class PoolAllocator;
+
+  shared_ptr<BlockPool> m_pool;
+};
+
+} // anonymous namespace
+
+/**
+ * \brief Hierarchical timing wheel of scheduled events
+ *
+ * Time is divided into 1 ms ticks counted from the creation of the wheel.  Level 0 has
+ * one slot per tick of the current 256-tick rotation; each higher level has one slot per
+ * rotation of the level below.  An event is kept at the lowest level whose current rotation
+ * contains its tick, and moves down a level when the time reaches its slot.  Event nodes
+ * are taken from a free list that grows in chunks and are never returned to the system
+ * until the wheel is destroyed.  EventIds, together with their reference counts, come from
+ * a block pool that lives until the wheel and all EventIds it handed out are gone.
+ */
+class Scheduler::TimingWheel : noncopyable
+{
+public:
+  struct Link
+  {
+    Link* prev;
+    Link* next;
+  };
+
+  struct Node : Link
+  {
+    uint64_t tick;
+    Event event;
+    EventId eventId;
+  };
+
+  static const uint64_t NO_TICK = std::numeric_limits<uint64_t>::max();
+
+  TimingWheel();
+
+  ~TimingWheel();
+
+  bool
+  empty() const
+  {
+    return m_size == 0;
+  }
+
+  time::steady_clock::TimePoint
+  getTime(uint64_t tick) const
+  {
+    return m_start + TICK * tick;
+  }
+
+  /**
+   * \brief Get the last tick that has elapsed at \p time
+   */
+  uint64_t
+  getElapsedTick(const time::steady_clock::TimePoint& time) const;
+
+  /**
+   * \brief Add an event due at \p time, which is rounded up to the next tick
+   */
+  Node*
+  insert(const time::steady_clock::TimePoint& time, const Event& event);
+
+  /**
+   * \brief Create the EventId of a node from the pool of the wheel
+   */
+  EventId
+  makeEventId(Node* node);
+
+  /**
+   * \brief Remove an event, whether it is still in the wheel or already expired
+   */
+  void
+  erase(Node* node);
+
+  /**
+   * \brief Advance the wheel to \p tick, moving all events due by then to the expired list
+   */
+  void
+  advance(uint64_t tick);
+
+  /**
+   * \brief Get the earliest expired event, or null if there is none
+   */
+  Node*
+  getNextExpired() const
+  {
+    return isListEmpty(m_expired) ? 0 : static_cast<Node*>(m_expired.next);
+  }
+
+  /**
+   * \brief Get the next tick at which advance() would have some work to do
+   */
+  uint64_t
+  getNextTick() const;
+
+  /**
+   * \brief Remove all events, invalidating their EventIds
+   */
+  void
+  clear();
+
+private:
+  static void
+  initList(Link& list)
+  {
+    list.prev = list.next = &list;
+  }
+
+  static bool
+  isListEmpty(const Link& list)
+  {
+    return list.next == &list;
+  }
+
+  static void
+  append(Link& list, Link* link)
+  {
+    link->prev = list.prev;
+    link->next = &list;
+    list.prev->next = link;
+    list.prev = link;
+  }
+
+  static void
+  unlink(Link* link)
+  {
+    link->prev->next = link->next;
+    link->next->prev = link->prev;
+  }
+
+  static void
+  splice(Link& from, Link& to);
+
+  /**
+   * \brief Put a node into the slot matching its tick relative to the current tick
+   */
+  void
+  place(Node* node);
+
+  /**
+   * \brief Re-place all nodes of a list relative to the current tick
+   */
+  void
+  cascade(Link& list);
+
+  void
+  clearList(Link& list);
+
+  Node*
+  allocate();
+
+  void
+  release(Node* node);
+
+private:
+  static const time::nanoseconds TICK;
+  static const size_t SLOT_BITS = 8;
+  static const size_t N_SLOTS = 1 << SLOT_BITS;
+  static const uint64_t SLOT_MASK = N_SLOTS - 1;
+  static const size_t N_LEVELS = 4;
+  static const size_t NODE_CHUNK_SIZE = 256;
+
+  time::steady_clock::TimePoint m_start;
+  uint64_t m_currentTick;
+  size_t m_size;
+
+  Link m_slots[N_LEVELS][N_SLOTS];
+  Link m_overflow; ///< events beyond the range of the top level
+  Link m_expired;  ///< events that are due but have not fired yet
+
+  std::vector<unique_ptr<Node[]>> m_nodeChunks;
+  Node* m_freeNodes;
+
+  shared_ptr<BlockPool> m_eventIdPool;
+};
+
+const uint64_t Scheduler::TimingWheel::NO_TICK;
+const time::nanoseconds Scheduler::TimingWheel::TICK = time::milliseconds(1);
+
 struct EventIdImpl
 {
   EventIdImpl(const Scheduler::EventQueue::iterator& event)
     : m_event(event)
+    , m_node(0)
+    , m_isValid(true)
+  {
+  }
+
+  explicit
+  EventIdImpl(Scheduler::TimingWheel::Node* node)
+    : m_node(node)
     , m_isValid(true)
   {
   }
@@ -57,11 +366,216 @@ struct EventIdImpl
     m_isValid = true;
   }
 
+  Scheduler::TimingWheel::Node*
+  getNode() const
+  {
+    return m_node;
+  }
+
 private:
   Scheduler::EventQueue::iterator m_event;
+  Scheduler::TimingWheel::Node* m_node;
   bool m_isValid;
 };
 
+Scheduler::TimingWheel::TimingWheel()
+  : m_start(time::steady_clock::now())
+  , m_currentTick(0)
+  , m_size(0)
+  , m_freeNodes(0)
+  , m_eventIdPool(make_shared<BlockPool>())
+{
+  for (size_t level = 0; level < N_LEVELS; ++level) {
+    for (size_t slot = 0; slot < N_SLOTS; ++slot) {
+      initList(m_slots[level][slot]);
+    }
+  }
+  initList(m_overflow);
+  initList(m_expired);
+}
+
+Scheduler::TimingWheel::~TimingWheel()
+{
+  clear();
+}
+
+uint64_t
+Scheduler::TimingWheel::getElapsedTick(const time::steady_clock::TimePoint& time) const
+{
+  if (time <= m_start)
+    return 0;
+
+  return static_cast<uint64_t>((time - m_start) / TICK);
+}
+
+Scheduler::TimingWheel::Node*
+Scheduler::TimingWheel::insert(const time::steady_clock::TimePoint& time, const Event& event)
+{
+  Node* node = allocate();
+  node->event = event;
+
+  // round up, so that the event never fires early
+  uint64_t tick = getElapsedTick(time);
+  if (getTime(tick) < time)
+    ++tick;
+  node->tick = std::max(tick, m_currentTick + 1);
+
+  place(node);
+  ++m_size;
+  return node;
+}
+
+EventId
+Scheduler::TimingWheel::makeEventId(Node* node)
+{
+  return std::allocate_shared<EventIdImpl>(PoolAllocator<EventIdImpl>(m_eventIdPool), node);
+}
+
+void
+Scheduler::TimingWheel::erase(Node* node)
+{
+  unlink(node);
+  --m_size;
+  release(node);
+}
+
+void
+Scheduler::TimingWheel::advance(uint64_t tick)
+{
+  while (true) {
+    uint64_t nextTick = getNextTick();
+    if (nextTick > tick) {
+      m_currentTick = std::max(m_currentTick, tick);
+      return;
+    }
+
+    m_currentTick = nextTick;
+
+    if ((m_currentTick & SLOT_MASK) == 0) {
+      size_t level = 1;
+      for (; level < N_LEVELS; ++level) {
+        uint64_t slot = (m_currentTick >> (SLOT_BITS * level)) & SLOT_MASK;
+        cascade(m_slots[level][slot]);
+        if (slot != 0)
+          break;
+      }
+      if (level == N_LEVELS)
+        cascade(m_overflow);
+    }
+
+    splice(m_slots[0][m_currentTick & SLOT_MASK], m_expired);
+  }
+}
+
+uint64_t
+Scheduler::TimingWheel::getNextTick() const
+{
+  for (size_t level = 0; level < N_LEVELS; ++level) {
+    size_t shift = SLOT_BITS * level;
+    uint64_t rotationStart = (m_currentTick >> (shift + SLOT_BITS)) << (shift + SLOT_BITS);
+
+    for (uint64_t slot = ((m_currentTick >> shift) & SLOT_MASK) + 1; slot < N_SLOTS; ++slot) {
+      if (!isListEmpty(m_slots[level][slot]))
+        return rotationStart + (slot << shift);
+    }
+  }
+
+  if (!isListEmpty(m_overflow))
+    return ((m_currentTick >> (SLOT_BITS * N_LEVELS)) + 1) << (SLOT_BITS * N_LEVELS);
+
+  return NO_TICK;
+}
+
+void
+Scheduler::TimingWheel::clear()
+{
+  for (size_t level = 0; level < N_LEVELS; ++level) {
+    for (size_t slot = 0; slot < N_SLOTS; ++slot) {
+      clearList(m_slots[level][slot]);
+    }
+  }
+  clearList(m_overflow);
+  clearList(m_expired);
+}
+
+void
+Scheduler::TimingWheel::clearList(Link& list)
+{
+  while (!isListEmpty(list)) {
+    Node* node = static_cast<Node*>(list.next);
+    node->eventId->invalidate();
+    erase(node);
+  }
+}
+
+void
+Scheduler::TimingWheel::splice(Link& from, Link& to)
+{
+  if (isListEmpty(from))
+    return;
+
+  from.next->prev = to.prev;
+  to.prev->next = from.next;
+  from.prev->next = &to;
+  to.prev = from.prev;
+  initList(from);
+}
+
+void
+Scheduler::TimingWheel::place(Node* node)
+{
+  for (size_t level = 0; level < N_LEVELS; ++level) {
+    size_t shift = SLOT_BITS * (level + 1);
+    if ((node->tick >> shift) == (m_currentTick >> shift)) {
+      append(m_slots[level][(node->tick >> (SLOT_BITS * level)) & SLOT_MASK], node);
+      return;
+    }
+  }
+
+  append(m_overflow, node);
+}
+
+void
+Scheduler::TimingWheel::cascade(Link& list)
+{
+  Link nodes;
+  initList(nodes);
+  splice(list, nodes);
+
+  while (!isListEmpty(nodes)) {
+    Node* node = static_cast<Node*>(nodes.next);
+    unlink(node);
+    place(node);
+  }
+}
+
+Scheduler::TimingWheel::Node*
+Scheduler::TimingWheel::allocate()
+{
+  if (m_freeNodes == 0) {
+    m_nodeChunks.push_back(unique_ptr<Node[]>(new Node[NODE_CHUNK_SIZE]));
+    Node* chunk = m_nodeChunks.back().get();
+    for (size_t i = 0; i < NODE_CHUNK_SIZE; ++i) {
+      chunk[i].next = m_freeNodes;
+      m_freeNodes = &chunk[i];
+    }
+  }
+
+  Node* node = m_freeNodes;
+  m_freeNodes = static_cast<Node*>(node->next);
+  return node;
+}
+
+void
+Scheduler::TimingWheel::release(Node* node)
+{
+  node->event = Event();
+  node->eventId.reset();
+
+  node->next = m_freeNodes;
+  m_freeNodes = node;
+}
+
 Scheduler::EventInfo::EventInfo(const time::nanoseconds& after,
                                 const Event& event)
   : m_scheduledTime(time::steady_clock::now() + after)
@@ -88,10 +602,17 @@ Scheduler::EventInfo::expiresFromNow() const
 }
 
 
-Scheduler::Scheduler(boost::asio::io_service& ioService)
+Scheduler::Scheduler(boost::asio::io_service& ioService, QueueType queueType)
   : m_scheduledEvent(m_events.end())
   , m_deadlineTimer(ioService)
+  , m_timingWheelTimerTick(TimingWheel::NO_TICK)
   , m_isEventExecuting(false)
+{
+  if (queueType == QUEUE_TIMING_WHEEL)
+    m_timingWheel.reset(new TimingWheel);
+}
+
+Scheduler::~Scheduler()
 {
 }
 
@@ -99,6 +620,17 @@ EventId
 Scheduler::scheduleEvent(const time::nanoseconds& after,
                          const Event& event)
 {
+  if (static_cast<bool>(m_timingWheel))
+    {
+      TimingWheel::Node* node = m_timingWheel->insert(time::steady_clock::now() + after, event);
+      node->eventId = m_timingWheel->makeEventId(node);
+
+      if (!m_isEventExecuting && node->tick < m_timingWheelTimerTick)
+        scheduleTimingWheelTimer(node->tick);
+
+      return node->eventId;
+    }
+
   EventQueue::iterator i = m_events.insert(EventInfo(after, event));
 
   // On OSX 10.9, boost, and C++03 the following doesn't work without ndn::
@@ -125,6 +657,19 @@ Scheduler::cancelEvent(const EventId& eventId)
   if (!static_cast<bool>(eventId) || !eventId->isValid())
     return; // event already fired or cancelled
 
+  if (static_cast<bool>(m_timingWheel))
+    {
+      eventId->invalidate();
+      m_timingWheel->erase(eventId->getNode());
+
+      if (!m_isEventExecuting && m_timingWheel->empty())
+        {
+          m_deadlineTimer.cancel();
+          m_timingWheelTimerTick = TimingWheel::NO_TICK;
+        }
+      return;
+    }
+
   if (static_cast<EventQueue::iterator>(*eventId) != m_scheduledEvent) {
     m_events.erase(*eventId);
     eventId->invalidate();
@@ -155,6 +700,12 @@ Scheduler::cancelAllEvents()
 {
   m_events.clear();
   m_deadlineTimer.cancel();
+
+  if (static_cast<bool>(m_timingWheel))
+    {
+      m_timingWheel->clear();
+      m_timingWheelTimerTick = TimingWheel::NO_TICK;
+    }
 }
 
 void
@@ -194,5 +745,47 @@ Scheduler::onEvent(const boost::system::error_code& error)
   m_isEventExecuting = false;
 }
 
+void
+Scheduler::onTimingWheelEvent(const boost::system::error_code& error)
+{
+  if (error) // e.g., cancelled
+    {
+      return;
+    }
+
+  m_isEventExecuting = true;
+  m_timingWheelTimerTick = TimingWheel::NO_TICK;
+
+  // collect all expired events first, so that event handlers can cancel any of them
+  m_timingWheel->advance(m_timingWheel->getElapsedTick(time::steady_clock::now()));
+
+  while (TimingWheel::Node* node = m_timingWheel->getNextExpired())
+    {
+      Event event;
+      event.swap(node->event);
+      node->eventId->invalidate();
+      m_timingWheel->erase(node);
+
+      event();
+    }
+
+  m_isEventExecuting = false;
+
+  uint64_t nextTick = m_timingWheel->getNextTick();
+  if (nextTick != TimingWheel::NO_TICK)
+    scheduleTimingWheelTimer(nextTick);
+}
+
+void
+Scheduler::scheduleTimingWheelTimer(uint64_t tick)
+{
+  time::steady_clock::TimePoint now = time::steady_clock::now();
+  time::steady_clock::TimePoint expiry = m_timingWheel->getTime(tick);
+
+  m_deadlineTimer.expires_from_now(expiry > now ? expiry - now : time::nanoseconds::zero());
+  m_deadlineTimer.async_wait(bind(&Scheduler::onTimingWheelEvent, this, _1));
+  m_timingWheelTimerTick = tick;
+}
+
 
 } // namespace ndn
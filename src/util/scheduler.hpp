@@ -43,7 +43,33 @@ class Scheduler
 public:
   typedef function<void()> Event;
 
-  Scheduler(boost::asio::io_service& ioService);
+  /**
+   * \brief Implementation of the scheduled event queue
+   */
+  enum QueueType {
+    /**
+     * \brief Ordered set of events
+     *
+     * Events fire at their exact scheduled time.  Scheduling and cancelling take
+     * logarithmic time.
+     */
+    QUEUE_ORDERED_SET,
+    /**
+     * \brief Hierarchical timing wheel with pooled event nodes
+     *
+     * Scheduled times are rounded up to whole milliseconds, and events due in the same
+     * millisecond fire in unspecified order.  Scheduling and cancelling take constant time,
+     * which suits workloads that schedule and cancel large numbers of events.  EventIds
+     * are taken from a pool of the scheduler as well, so the last copy of an EventId must
+     * be released in the thread that runs the scheduler.
+     */
+    QUEUE_TIMING_WHEEL
+  };
+
+  explicit
+  Scheduler(boost::asio::io_service& ioService, QueueType queueType = QUEUE_ORDERED_SET);
+
+  ~Scheduler();
 
   /**
    * \brief Schedule one time event after the specified delay
@@ -68,6 +94,12 @@ private:
   void
   onEvent(const boost::system::error_code& code);
 
+  void
+  onTimingWheelEvent(const boost::system::error_code& code);
+
+  void
+  scheduleTimingWheelTimer(uint64_t tick);
+
 private:
   struct EventInfo
   {
@@ -96,12 +128,16 @@ private:
   };
 
   typedef std::multiset<EventInfo> EventQueue;
+  class TimingWheel;
   friend struct EventIdImpl;
 
   EventQueue m_events;
   EventQueue::iterator m_scheduledEvent;
   monotonic_deadline_timer m_deadlineTimer;
 
+  unique_ptr<TimingWheel> m_timingWheel; ///< set if QUEUE_TIMING_WHEEL is used
+  uint64_t m_timingWheelTimerTick;       ///< tick at which m_deadlineTimer is set to expire
+
   bool m_isEventExecuting;
 };
 
@@ -26,16 +26,56 @@
 namespace ndn {
 namespace util {
 
+SegmentFetcher::Options::Options()
+  : initialWindow(1.0)
+  , maxWindow(std::numeric_limits<double>::max())
+  , initialSsthresh(std::numeric_limits<double>::max())
+  , aiStep(1.0)
+  , mdCoef(0.5)
+  , maxRetries(3)
+  , useAdaptiveRto(true)
+  , initialRto(time::seconds(1))
+  , minRto(time::milliseconds(200))
+  , maxRto(time::seconds(4))
+  , maxReorderSegments(1024)
+{
+}
+
+static SegmentFetcher::Options
+makeStopAndWaitOptions()
+{
+  SegmentFetcher::Options options;
+  options.maxWindow = 1.0;
+  options.maxRetries = 0;
+  options.useAdaptiveRto = false;
+  return options;
+}
+
 SegmentFetcher::SegmentFetcher(Face& face,
                                const VerifySegment& verifySegment,
                                const CompleteCallback& completeCallback,
-                               const ErrorCallback& errorCallback)
+                               const ErrorCallback& errorCallback,
+                               const Options& options)
   : m_face(face)
   , m_verifySegment(verifySegment)
   , m_completeCallback(completeCallback)
   , m_errorCallback(errorCallback)
+  , m_options(options)
   , m_buffer(make_shared<OBufferStream>())
+  , m_isStopped(false)
+  , m_nextSegmentNo(0)
+  , m_nextDeliveredSegmentNo(0)
+  , m_hasFinalSegmentNo(false)
+  , m_finalSegmentNo(0)
+  , m_window(std::max(1.0, std::min(options.initialWindow, options.maxWindow)))
+  , m_ssthresh(options.initialSsthresh)
+  , m_recoveryPoint(0)
+  , m_hasRttMeasurement(false)
+  , m_srtt(time::nanoseconds::zero())
+  , m_rttVar(time::nanoseconds::zero())
+  , m_rto(options.initialRto)
 {
+  m_options.maxReorderSegments = std::max<size_t>(m_options.maxReorderSegments, 1);
 }
 
 void
@@ -44,10 +84,22 @@ SegmentFetcher::fetch(Face& face,
                       const VerifySegment& verifySegment,
                       const CompleteCallback& completeCallback,
                       const ErrorCallback& errorCallback)
+{
+  fetch(face, baseInterest, verifySegment, completeCallback, errorCallback,
+        makeStopAndWaitOptions());
+}
+
+void
+SegmentFetcher::fetch(Face& face,
+                      const Interest& baseInterest,
+                      const VerifySegment& verifySegment,
+                      const CompleteCallback& completeCallback,
+                      const ErrorCallback& errorCallback,
+                      const Options& options)
 {
   shared_ptr<SegmentFetcher> fetcher =
     shared_ptr<SegmentFetcher>(new SegmentFetcher(face, verifySegment,
-                                                  completeCallback, errorCallback));
+                                                  completeCallback, errorCallback, options));
 
   fetcher->fetchFirstSegment(baseInterest, fetcher);
 }
@@ -60,59 +112,296 @@ SegmentFetcher::fetchFirstSegment(const Interest& baseInterest,
   interest.setChildSelector(1);
   interest.setMustBeFresh(true);
 
+  m_segmentInterest = baseInterest; // to preserve any special selectors
+  m_segmentInterest.setChildSelector(0);
+  m_segmentInterest.setMustBeFresh(false);
+
   m_face.expressInterest(interest,
-                         bind(&SegmentFetcher::onSegmentReceived, this, _1, _2, true, self),
-                         bind(m_errorCallback, INTEREST_TIMEOUT, "Timeout"));
+                         bind(&SegmentFetcher::onFirstSegmentReceived, this, _2,
+                              time::steady_clock::now(), self),
+                         bind(&SegmentFetcher::fail, this, INTEREST_TIMEOUT, "Timeout"));
 }
 
 void
-SegmentFetcher::fetchNextSegment(const Interest& origInterest, const Name& dataName,
-                                 uint64_t segmentNo,
-                                 const shared_ptr<SegmentFetcher>& self)
+SegmentFetcher::onFirstSegmentReceived(const Data& data,
+                                       const time::steady_clock::TimePoint& sendTime,
+                                       const shared_ptr<SegmentFetcher>& self)
 {
-  Interest interest(origInterest); // to preserve any special selectors
+  if (m_isStopped)
+    return;
+
+  if (!m_verifySegment(data)) {
+    return fail(SEGMENT_VERIFICATION_FAIL, "Segment validation fail");
+  }
+
+  uint64_t segmentNo = 0;
+  try {
+    segmentNo = data.getName().get(-1).toSegment();
+  }
+  catch (const tlv::Error& e) {
+    return fail(DATA_HAS_NO_SEGMENT, std::string("Error while decoding segment: ") + e.what());
+  }
+
+  m_versionedName = NameBuilder(data.getName().getPrefix(-1));
+
+  if (segmentNo != 0) {
+    // the latest version is known now, but the object has to be fetched from its beginning
+    addRttMeasurement(time::steady_clock::now() - sendTime);
+    return fetchSegments(self);
+  }
+
+  m_nextSegmentNo = 1;
+
+  std::map<uint64_t, PendingSegment>::iterator pending =
+    m_pendingSegments.insert(std::make_pair(0, PendingSegment())).first;
+  pending->second.pendingInterestId = 0;
+  pending->second.sendTime = sendTime;
+  pending->second.nRetries = 0;
+  // already verified above
+  acceptSegment(pending, data, self);
+}
+
+void
+SegmentFetcher::fetchSegments(const shared_ptr<SegmentFetcher>& self)
+{
+  while (!m_isStopped && m_pendingSegments.size() < static_cast<size_t>(m_window)) {
+    if (!m_retxQueue.empty()) {
+      fetchSegment(m_retxQueue.begin()->first, self);
+    }
+    else if ((!m_hasFinalSegmentNo || m_nextSegmentNo <= m_finalSegmentNo) &&
+             m_nextSegmentNo - m_nextDeliveredSegmentNo < m_options.maxReorderSegments) {
+      fetchSegment(m_nextSegmentNo++, self);
+    }
+    else {
+      break;
+    }
+  }
+}
+
+void
+SegmentFetcher::fetchSegment(uint64_t segmentNo, const shared_ptr<SegmentFetcher>& self)
+{
+  size_t nRetries = 0;
+  std::map<uint64_t, size_t>::iterator retx = m_retxQueue.find(segmentNo);
+  if (retx != m_retxQueue.end()) {
+    nRetries = retx->second;
+    m_retxQueue.erase(retx);
+  }
+
+  Interest interest(m_segmentInterest);
   interest.refreshNonce();
-  interest.setChildSelector(0);
-  interest.setMustBeFresh(false);
-  interest.setName(dataName.getPrefix(-1).appendSegment(segmentNo));
-  m_face.expressInterest(interest,
-                         bind(&SegmentFetcher::onSegmentReceived, this, _1, _2, false, self),
-                         bind(m_errorCallback, INTEREST_TIMEOUT, "Timeout"));
+  interest.setName(m_versionedName.appendSegment(segmentNo));
+  if (m_options.useAdaptiveRto)
+    interest.setInterestLifetime(time::duration_cast<time::milliseconds>(m_rto));
+
+  PendingSegment& pending = m_pendingSegments[segmentNo];
+  pending.sendTime = time::steady_clock::now();
+  pending.nRetries = nRetries;
+  pending.pendingInterestId =
+    m_face.expressInterest(interest,
+                           bind(&SegmentFetcher::onSegmentReceived, this, segmentNo, _2, self),
+                           bind(&SegmentFetcher::onSegmentTimeout, this, segmentNo, self));
 }
 
 void
-SegmentFetcher::onSegmentReceived(const Interest& origInterest,
-                                  const Data& data, bool isSegmentZeroExpected,
+SegmentFetcher::onSegmentReceived(uint64_t segmentNo, const Data& data,
                                   const shared_ptr<SegmentFetcher>& self)
 {
+  if (m_isStopped)
+    return;
+
+  std::map<uint64_t, PendingSegment>::iterator pending = m_pendingSegments.find(segmentNo);
+  if (pending == m_pendingSegments.end())
+    return;
+
   if (!m_verifySegment(data)) {
-    return m_errorCallback(SEGMENT_VERIFICATION_FAIL, "Segment validation fail");
+    return fail(SEGMENT_VERIFICATION_FAIL, "Segment validation fail");
+  }
+
+  acceptSegment(pending, data, self);
+}
+
+void
+SegmentFetcher::acceptSegment(std::map<uint64_t, PendingSegment>::iterator pending,
+                              const Data& data, const shared_ptr<SegmentFetcher>& self)
+{
+  uint64_t segmentNo = pending->first;
+
+  try {
+    updateFinalSegment(data);
+  }
+  catch (const tlv::Error& e) {
+    return fail(DATA_HAS_NO_SEGMENT, std::string("Error while decoding segment: ") + e.what());
+  }
+
+  // Karn's algorithm: only segments that were not retransmitted give valid RTT samples
+  if (pending->second.nRetries == 0)
+    addRttMeasurement(time::steady_clock::now() - pending->second.sendTime);
+  m_pendingSegments.erase(pending);
+
+  if (m_window < m_ssthresh)
+    m_window += 1.0;
+  else
+    m_window += m_options.aiStep / m_window;
+  m_window = std::min(m_window, m_options.maxWindow);
+
+  if (segmentNo >= m_nextDeliveredSegmentNo) {
+    shared_ptr<const Data> segment;
+    try {
+      segment = data.shared_from_this();
+    }
+    catch (const bad_weak_ptr&) {
+      segment = make_shared<Data>(data);
+    }
+    m_receivedSegments[segmentNo] = segment;
   }
 
   try {
-    uint64_t currentSegment = data.getName().get(-1).toSegment();
+    deliverSegments();
+  }
+  catch (const SegmentSink::Error& e) {
+    return fail(SINK_ERROR, e.what());
+  }
+
+  if (m_hasFinalSegmentNo && m_nextDeliveredSegmentNo > m_finalSegmentNo)
+    return finish();
+
+  fetchSegments(self);
+}
+
+void
+SegmentFetcher::onSegmentTimeout(uint64_t segmentNo, const shared_ptr<SegmentFetcher>& self)
+{
+  if (m_isStopped)
+    return;
+
+  std::map<uint64_t, PendingSegment>::iterator pending = m_pendingSegments.find(segmentNo);
+  if (pending == m_pendingSegments.end())
+    return;
+
+  size_t nRetries = pending->second.nRetries;
+  m_pendingSegments.erase(pending);
+
+  if (nRetries >= m_options.maxRetries) {
+    return fail(INTEREST_TIMEOUT, "Timeout");
+  }
+
+  // react at most once per window of data, unless a retransmission is lost again
+  bool isNewLoss = segmentNo >= m_recoveryPoint;
+  if (isNewLoss) {
+    m_ssthresh = std::max(1.0, m_window * m_options.mdCoef);
+    m_window = m_ssthresh;
+    m_recoveryPoint = m_nextSegmentNo;
+  }
+
+  if (m_options.useAdaptiveRto && (isNewLoss || nRetries > 0))
+    m_rto = std::min<time::nanoseconds>(m_rto * 2, m_options.maxRto);
 
-    if (isSegmentZeroExpected && currentSegment != 0) {
-      fetchNextSegment(origInterest, data.getName(), 0, self);
+  m_retxQueue[segmentNo] = nRetries + 1;
+  fetchSegments(self);
+}
+
+void
+SegmentFetcher::updateFinalSegment(const Data& data)
+{
+  const name::Component& finalBlockId = data.getMetaInfo().getFinalBlockId();
+  if (finalBlockId.empty() || m_hasFinalSegmentNo)
+    return;
+
+  m_hasFinalSegmentNo = true;
+  m_finalSegmentNo = finalBlockId.toSegment();
+
+  // segments past the end of the object will never arrive
+  std::map<uint64_t, PendingSegment>::iterator i =
+    m_pendingSegments.upper_bound(m_finalSegmentNo);
+  while (i != m_pendingSegments.end()) {
+    m_face.removePendingInterest(i->second.pendingInterestId);
+    m_pendingSegments.erase(i++);
+  }
+  m_retxQueue.erase(m_retxQueue.upper_bound(m_finalSegmentNo), m_retxQueue.end());
+}
+
+void
+SegmentFetcher::deliverSegments()
+{
+  std::map<uint64_t, shared_ptr<const Data>>::iterator i = m_receivedSegments.begin();
+  while (i != m_receivedSegments.end() && i->first == m_nextDeliveredSegmentNo) {
+    const Data& segment = *i->second;
+    if (static_cast<bool>(m_options.onSegment)) {
+      m_options.onSegment(segment);
+    }
+    else if (static_cast<bool>(m_options.sink)) {
+      m_options.sink->write(segment.getContent().value(), segment.getContent().value_size());
     }
     else {
-      m_buffer->write(reinterpret_cast<const char*>(data.getContent().value()),
-                      data.getContent().value_size());
-
-      const name::Component& finalBlockId = data.getMetaInfo().getFinalBlockId();
-      if (finalBlockId.empty() ||
-          finalBlockId.toSegment() > currentSegment)
-        {
-          fetchNextSegment(origInterest, data.getName(), currentSegment + 1, self);
-        }
-      else {
-        return m_completeCallback(m_buffer->buf());
-      }
+      m_buffer->write(reinterpret_cast<const char*>(segment.getContent().value()),
+                      segment.getContent().value_size());
     }
+
+    m_receivedSegments.erase(i++);
+    ++m_nextDeliveredSegmentNo;
   }
-  catch (const tlv::Error& e) {
-    m_errorCallback(DATA_HAS_NO_SEGMENT, std::string("Error while decoding segment: ") + e.what());
+}
+
+void
+SegmentFetcher::addRttMeasurement(const time::nanoseconds& rtt)
+{
+  // RFC 6298
+  if (!m_hasRttMeasurement) {
+    m_hasRttMeasurement = true;
+    m_srtt = rtt;
+    m_rttVar = rtt / 2;
+  }
+  else {
+    time::nanoseconds delta = m_srtt > rtt ? m_srtt - rtt : rtt - m_srtt;
+    m_rttVar = (m_rttVar * 3 + delta) / 4;
+    m_srtt = (m_srtt * 7 + rtt) / 8;
+  }
+
+  m_rto = m_srtt + m_rttVar * 4;
+  m_rto = std::max<time::nanoseconds>(m_rto, m_options.minRto);
+  m_rto = std::min<time::nanoseconds>(m_rto, m_options.maxRto);
+}
+
+void
+SegmentFetcher::finish()
+{
+  stop();
+
+  if (static_cast<bool>(m_options.sink)) {
+    try {
+      m_options.sink->finish();
+    }
+    catch (const SegmentSink::Error& e) {
+      return m_errorCallback(SINK_ERROR, e.what());
+    }
+  }
+
+  m_completeCallback(m_buffer->buf());
+}
+
+void
+SegmentFetcher::fail(uint32_t code, const std::string& msg)
+{
+  if (m_isStopped)
+    return;
+
+  stop();
+  m_errorCallback(code, msg);
+}
+
+void
+SegmentFetcher::stop()
+{
+  m_isStopped = true;
+
+  for (std::map<uint64_t, PendingSegment>::iterator i = m_pendingSegments.begin();
+       i != m_pendingSegments.end(); ++i) {
+    m_face.removePendingInterest(i->second.pendingInterestId);
   }
+  m_pendingSegments.clear();
+  m_retxQueue.clear();
+  m_receivedSegments.clear();
 }
 
 } // util
@@ -24,6 +24,10 @@
 
 #include "../common.hpp"
 #include "../face.hpp"
+#include "../name-builder.hpp"
+#include "segment-sink.hpp"
+
+#include <map>
 
 namespace ndn {
 
@@ -83,6 +87,13 @@ public:
  * - `DATA_HAS_NO_SEGMENT`: if any of the retrieved Data packets don't have segment
  *   as a last component of the name (not counting implicit digest)
  * - `SEGMENT_VERIFICATION_FAIL`: if any retrieved segment fails user-provided validation
+ * - `SINK_ERROR`: if the SegmentSink given in Options cannot accept the content
+ *
+ * When fetched with Options that allow a congestion window larger than one segment, steps 5
+ * and 6 are pipelined: Interests for several segments are kept outstanding, the window
+ * follows AIMD with slow start, timed out segments are retransmitted up to
+ * Options::maxRetries times, and out-of-order segments are reassembled before delivery.
+ * Timeouts then only abort fetching once a segment has run out of retransmissions.
  *
  * In order to validate individual segments, an VerifySegment callback needs to be specified.
  * If the callback returns false, fetching process is aborted with SEGMENT_VERIFICATION_FAIL.
@@ -116,13 +127,79 @@ public:
   typedef function<bool (const Data& data)> VerifySegment;
   typedef function<void (uint32_t code, const std::string& msg)> ErrorCallback;
 
+  /**
+   * @brief Callback receiving Data segments in segment order
+   */
+  typedef function<void (const Data& segment)> SegmentCallback;
+
   /**
    * @brief Error codes that can be passed to ErrorCallback
    */
   enum ErrorCode {
     INTEREST_TIMEOUT = 1,
     DATA_HAS_NO_SEGMENT = 2,
-    SEGMENT_VERIFICATION_FAIL = 3
+    SEGMENT_VERIFICATION_FAIL = 3,
+    SINK_ERROR = 4
+  };
+
+  /**
+   * @brief Parameters of the segment pipeline
+   *
+   * Default values enable pipelining with retransmissions and adaptive retransmission
+   * timeout.  The fetch() overload without Options uses a window of one segment, no
+   * retransmissions and the lifetime of the base Interest, i.e., stop-and-wait fetching.
+   */
+  struct Options
+  {
+    Options();
+
+    /// initial congestion window, in segments
+    double initialWindow;
+    /// upper limit of the congestion window, in segments
+    double maxWindow;
+    /// initial slow start threshold, in segments
+    double initialSsthresh;
+    /// window increase per round trip in congestion avoidance, in segments
+    double aiStep;
+    /// factor applied to the window when a timeout is detected
+    double mdCoef;
+
+    /// maximum number of retransmissions of one segment before fetching fails
+    size_t maxRetries;
+
+    /**
+     * @brief Whether segment Interests use the estimated retransmission timeout as lifetime
+     *
+     * If false, all Interests use the lifetime of the base Interest.
+     */
+    bool useAdaptiveRto;
+    /// retransmission timeout before the first RTT measurement
+    time::milliseconds initialRto;
+    time::milliseconds minRto;
+    time::milliseconds maxRto;
+
+    /**
+     * @brief Maximum number of segments requested ahead of the next segment to be delivered
+     *
+     * This bounds the number of out-of-order segments held for reassembly, and therefore
+     * the memory used by the fetcher when the content goes to onSegment or sink.
+     */
+    size_t maxReorderSegments;
+
+    /**
+     * @brief If set, segments are passed to this callback in order instead of being buffered
+     *
+     * CompleteCallback then receives an empty buffer.
+     */
+    SegmentCallback onSegment;
+
+    /**
+     * @brief If set, segment content is written to this sink in order instead of being
+     *        buffered
+     *
+     * CompleteCallback is called with an empty buffer after SegmentSink::finish.
+     */
+    shared_ptr<SegmentSink> sink;
   };
 
   /**
@@ -149,31 +226,122 @@ public:
         const CompleteCallback& completeCallback,
         const ErrorCallback& errorCallback);
 
+  /**
+   * @brief Initiate segment fetching with the specified pipeline parameters
+   * @sa fetch(Face&, const Interest&, const VerifySegment&, const CompleteCallback&,
+   *           const ErrorCallback&)
+   */
+  static
+  void
+  fetch(Face& face,
+        const Interest& baseInterest,
+        const VerifySegment& verifySegment,
+        const CompleteCallback& completeCallback,
+        const ErrorCallback& errorCallback,
+        const Options& options);
+
 private:
+  struct PendingSegment
+  {
+    const PendingInterestId* pendingInterestId;
+    time::steady_clock::TimePoint sendTime;
+    size_t nRetries;
+  };
+
   SegmentFetcher(Face& face,
                  const VerifySegment& verifySegment,
                  const CompleteCallback& completeCallback,
-                 const ErrorCallback& errorCallback);
+                 const ErrorCallback& errorCallback,
+                 const Options& options);
 
   void
   fetchFirstSegment(const Interest& baseInterest, const shared_ptr<SegmentFetcher>& self);
 
+  /**
+   * @brief Express Interests for pending retransmissions and new segments
+   *        while the window allows
+   */
+  void
+  fetchSegments(const shared_ptr<SegmentFetcher>& self);
+
+  void
+  fetchSegment(uint64_t segmentNo, const shared_ptr<SegmentFetcher>& self);
+
   void
-  fetchNextSegment(const Interest& origInterest, const Name& dataName, uint64_t segmentNo,
-                   const shared_ptr<SegmentFetcher>& self);
+  onFirstSegmentReceived(const Data& data, const time::steady_clock::TimePoint& sendTime,
+                         const shared_ptr<SegmentFetcher>& self);
 
   void
-  onSegmentReceived(const Interest& origInterest,
-                    const Data& data, bool isSegmentZeroExpected,
+  onSegmentReceived(uint64_t segmentNo, const Data& data,
                     const shared_ptr<SegmentFetcher>& self);
 
+  void
+  onSegmentTimeout(uint64_t segmentNo, const shared_ptr<SegmentFetcher>& self);
+
+  /**
+   * @brief Process a segment that has passed verification
+   */
+  void
+  acceptSegment(std::map<uint64_t, PendingSegment>::iterator pending, const Data& data,
+                const shared_ptr<SegmentFetcher>& self);
+
+  /**
+   * @brief Record the FinalBlockId of @p data, if any, and cancel Interests past it
+   */
+  void
+  updateFinalSegment(const Data& data);
+
+  /**
+   * @brief Pass all buffered segments that are next in order to the output
+   */
+  void
+  deliverSegments();
+
+  void
+  addRttMeasurement(const time::nanoseconds& rtt);
+
+  void
+  finish();
+
+  void
+  fail(uint32_t code, const std::string& msg);
+
+  /**
+   * @brief Cancel all outstanding Interests and ignore any further events
+   */
+  void
+  stop();
+
 private:
   Face& m_face;
   VerifySegment m_verifySegment;
   CompleteCallback m_completeCallback;
   ErrorCallback m_errorCallback;
+  Options m_options;
 
   shared_ptr<OBufferStream> m_buffer;
+
+  bool m_isStopped;
+  Interest m_segmentInterest; ///< template of Interests for individual segments
+  NameBuilder m_versionedName;
+
+  uint64_t m_nextSegmentNo;        ///< next segment that has not been requested yet
+  uint64_t m_nextDeliveredSegmentNo;
+  bool m_hasFinalSegmentNo;
+  uint64_t m_finalSegmentNo;
+
+  std::map<uint64_t, PendingSegment> m_pendingSegments;
+  std::map<uint64_t, size_t> m_retxQueue; ///< segments to retransmit -> retransmission count
+  std::map<uint64_t, shared_ptr<const Data>> m_receivedSegments; ///< reorder buffer
+
+  double m_window;
+  double m_ssthresh;
+  uint64_t m_recoveryPoint; ///< window is not decreased again for segments below this one
+
+  bool m_hasRttMeasurement;
+  time::nanoseconds m_srtt;
+  time::nanoseconds m_rttVar;
+  time::nanoseconds m_rto;
 };
 
 } // util
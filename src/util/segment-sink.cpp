@@ -0,0 +1,179 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2014 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "segment-sink.hpp"
+
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ndn {
+namespace util {
+
+static std::string
+getErrorMessage(const std::string& what)
+{
+  return what + ": " + std::strerror(errno);
+}
+
+SegmentSink::~SegmentSink()
+{
+}
+
+void
+SegmentSink::finish()
+{
+}
+
+FileDescriptorSink::FileDescriptorSink(int fd)
+  : m_fd(fd)
+{
+}
+
+void
+FileDescriptorSink::write(const uint8_t* buffer, size_t size)
+{
+  while (size > 0) {
+    ssize_t nWritten = ::write(m_fd, buffer, size);
+    if (nWritten < 0) {
+      if (errno == EINTR)
+        continue;
+      throw Error(getErrorMessage("Cannot write to file descriptor"));
+    }
+
+    buffer += nWritten;
+    size -= nWritten;
+  }
+}
+
+MappedFileSink::MappedFileSink(const std::string& path, size_t windowSize)
+  : m_fd(::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644))
+  , m_window(0)
+  , m_windowOffset(0)
+  , m_size(0)
+{
+  if (m_fd < 0)
+    throw Error(getErrorMessage("Cannot open " + path));
+
+  size_t pageSize = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+  m_windowSize = std::max<size_t>((windowSize + pageSize - 1) / pageSize, 1) * pageSize;
+}
+
+MappedFileSink::~MappedFileSink()
+{
+  unmapWindow();
+
+  // drop the unused tail of the last window even if finish() was not called
+  if (::ftruncate(m_fd, static_cast<off_t>(m_size)) != 0) {
+    // nothing can be done about it here
+  }
+  ::close(m_fd);
+}
+
+void
+MappedFileSink::write(const uint8_t* buffer, size_t size)
+{
+  while (size > 0) {
+    if (m_window == 0 || m_size >= m_windowOffset + m_windowSize)
+      mapWindow(m_size - m_size % m_windowSize);
+
+    size_t offsetInWindow = static_cast<size_t>(m_size - m_windowOffset);
+    size_t nCopied = std::min(size, m_windowSize - offsetInWindow);
+    std::memcpy(m_window + offsetInWindow, buffer, nCopied);
+
+    buffer += nCopied;
+    size -= nCopied;
+    m_size += nCopied;
+  }
+}
+
+void
+MappedFileSink::finish()
+{
+  unmapWindow();
+
+  if (::ftruncate(m_fd, static_cast<off_t>(m_size)) != 0)
+    throw Error(getErrorMessage("Cannot truncate file"));
+}
+
+void
+MappedFileSink::mapWindow(uint64_t offset)
+{
+  unmapWindow();
+
+  allocate(offset, m_windowSize);
+
+  void* window = ::mmap(0, m_windowSize, PROT_READ | PROT_WRITE, MAP_SHARED,
+                        m_fd, static_cast<off_t>(offset));
+  if (window == MAP_FAILED)
+    throw Error(getErrorMessage("Cannot map file"));
+
+  m_window = static_cast<uint8_t*>(window);
+  m_windowOffset = offset;
+}
+
+void
+MappedFileSink::allocate(uint64_t offset, size_t length)
+{
+  // ftruncate alone would leave a sparse file, whose blocks are only allocated when the
+  // mapping is stored into; a full disk would then be reported by SIGBUS
+#ifdef NDN_CXX_HAVE_POSIX_FALLOCATE
+  int error = 0;
+  do {
+    error = ::posix_fallocate(m_fd, static_cast<off_t>(offset), static_cast<off_t>(length));
+  } while (error == EINTR);
+
+  if (error != 0) {
+    errno = error;
+    throw Error(getErrorMessage("Cannot extend file"));
+  }
+#else
+  // the blocks are allocated by writing zeros
+  static const uint8_t ZEROS[4096] = {0};
+  while (length > 0) {
+    ssize_t nWritten = ::pwrite(m_fd, ZEROS, std::min(length, sizeof(ZEROS)),
+                                static_cast<off_t>(offset));
+    if (nWritten < 0) {
+      if (errno == EINTR)
+        continue;
+      throw Error(getErrorMessage("Cannot extend file"));
+    }
+
+    offset += nWritten;
+    length -= nWritten;
+  }
+#endif // NDN_CXX_HAVE_POSIX_FALLOCATE
+}
+
+void
+MappedFileSink::unmapWindow()
+{
+  if (m_window == 0)
+    return;
+
+  ::munmap(m_window, m_windowSize);
+  m_window = 0;
+}
+
+} // namespace util
+} // namespace ndn
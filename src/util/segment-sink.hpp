@@ -0,0 +1,142 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2014 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_UTIL_SEGMENT_SINK_HPP
+#define NDN_UTIL_SEGMENT_SINK_HPP
+
+#include "../common.hpp"
+
+namespace ndn {
+namespace util {
+
+/**
+ * @brief Destination of the content fetched by SegmentFetcher
+ *
+ * SegmentFetcher writes the content of each segment to the sink in segment order, and
+ * calls finish() after the last segment.  A sink that cannot accept data should throw
+ * SegmentSink::Error, which aborts fetching with SegmentFetcher::SINK_ERROR.
+ */
+class SegmentSink : noncopyable
+{
+public:
+  class Error : public std::runtime_error
+  {
+  public:
+    explicit
+    Error(const std::string& what)
+      : std::runtime_error(what)
+    {
+    }
+  };
+
+  virtual
+  ~SegmentSink();
+
+  /**
+   * @brief Append @p size octets from @p buffer
+   */
+  virtual void
+  write(const uint8_t* buffer, size_t size) = 0;
+
+  /**
+   * @brief Complete the output after all content has been written
+   */
+  virtual void
+  finish();
+};
+
+/**
+ * @brief Sink that writes content to a file descriptor
+ *
+ * The file descriptor is not closed by the sink.
+ */
+class FileDescriptorSink : public SegmentSink
+{
+public:
+  explicit
+  FileDescriptorSink(int fd);
+
+  virtual void
+  write(const uint8_t* buffer, size_t size);
+
+private:
+  int m_fd;
+};
+
+/**
+ * @brief Sink that writes content to a file through a sliding memory mapping
+ *
+ * The file is created or truncated when the sink is constructed.  It is extended and mapped
+ * one window at a time, so only the current window is mapped regardless of the file size.
+ * Disk space for a window is allocated before it is mapped, so that running out of space
+ * is reported as SegmentSink::Error rather than by SIGBUS on a store into the mapping.
+ * finish() truncates the file to the amount of content written.
+ */
+class MappedFileSink : public SegmentSink
+{
+public:
+  /**
+   * @param path        file to write
+   * @param windowSize  size of the mapped window, rounded up to a multiple of the page size
+   * @throw SegmentSink::Error the file cannot be opened
+   */
+  explicit
+  MappedFileSink(const std::string& path, size_t windowSize = 16 * 1024 * 1024);
+
+  virtual
+  ~MappedFileSink();
+
+  virtual void
+  write(const uint8_t* buffer, size_t size);
+
+  virtual void
+  finish();
+
+private:
+  /**
+   * @brief Extend the file to cover the window at @p offset and map it
+   * @throw SegmentSink::Error disk space cannot be allocated, or the window cannot be mapped
+   */
+  void
+  mapWindow(uint64_t offset);
+
+  /**
+   * @brief Allocate disk space for @p length octets at @p offset, extending the file
+   * @throw SegmentSink::Error disk space cannot be allocated
+   */
+  void
+  allocate(uint64_t offset, size_t length);
+
+  void
+  unmapWindow();
+
+private:
+  int m_fd;
+  size_t m_windowSize;
+  uint8_t* m_window;       ///< mapped window, or null
+  uint64_t m_windowOffset; ///< file offset of the mapped window
+  uint64_t m_size;         ///< number of octets written
+};
+
+} // namespace util
+} // namespace ndn
+
+#endif // NDN_UTIL_SEGMENT_SINK_HPP
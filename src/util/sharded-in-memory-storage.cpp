@@ -0,0 +1,188 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2014 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "sharded-in-memory-storage.hpp"
+
+namespace ndn {
+namespace util {
+
+const size_t ShardedInMemoryStorage::ALL_SHARDS = std::numeric_limits<size_t>::max();
+
+ShardedInMemoryStorage::ShardedInMemoryStorage(size_t nShards, size_t shardPrefixLength,
+                                               const StorageFactory& makeStorage)
+  : m_shardPrefixLength(shardPrefixLength)
+{
+  BOOST_ASSERT(nShards > 0);
+
+  for (size_t i = 0; i < nShards; ++i) {
+    unique_ptr<Shard> shard(new Shard);
+    shard->storage = makeStorage();
+    m_shards.push_back(std::move(shard));
+  }
+}
+
+void
+ShardedInMemoryStorage::insert(const Data& data)
+{
+  // Materialize every lazily decoded field before the packet is published: once stored,
+  // it is read through const getters by whichever threads find it.
+  data.getMetaInfo();
+  data.getSignature();
+  data.getFullName();
+
+  Shard& shard = *m_shards[getShardOfData(data.getName())];
+
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  shard.storage->insert(data);
+}
+
+shared_ptr<const Data>
+ShardedInMemoryStorage::find(const Interest& interest)
+{
+  size_t shardIndex = getShardOfPrefix(interest.getName());
+  if (shardIndex != ALL_SHARDS) {
+    Shard& shard = *m_shards[shardIndex];
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    return shard.storage->find(interest);
+  }
+
+  shared_ptr<const Data> best;
+  for (size_t i = 0; i < m_shards.size(); ++i) {
+    shared_ptr<const Data> found;
+    {
+      std::lock_guard<std::mutex> lock(m_shards[i]->mutex);
+      found = m_shards[i]->storage->find(interest);
+    }
+
+    if (found != nullptr && (best == nullptr || isBetterMatch(interest, *found, *best)))
+      best = found;
+  }
+  return best;
+}
+
+shared_ptr<const Data>
+ShardedInMemoryStorage::find(const Name& name)
+{
+  size_t shardIndex = getShardOfPrefix(name);
+  if (shardIndex != ALL_SHARDS) {
+    Shard& shard = *m_shards[shardIndex];
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    return shard.storage->find(name);
+  }
+
+  shared_ptr<const Data> best;
+  for (size_t i = 0; i < m_shards.size(); ++i) {
+    shared_ptr<const Data> found;
+    {
+      std::lock_guard<std::mutex> lock(m_shards[i]->mutex);
+      found = m_shards[i]->storage->find(name);
+    }
+
+    if (found != nullptr && (best == nullptr || found->getFullName() < best->getFullName()))
+      best = found;
+  }
+  return best;
+}
+
+void
+ShardedInMemoryStorage::erase(const Name& prefix, bool isPrefix)
+{
+  size_t shardIndex = getShardOfPrefix(prefix);
+  if (shardIndex != ALL_SHARDS) {
+    Shard& shard = *m_shards[shardIndex];
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.storage->erase(prefix, isPrefix);
+    return;
+  }
+
+  // shards are always locked in the same order, and no other operation holds
+  // more than one shard lock, so this cannot deadlock
+  std::vector<std::unique_lock<std::mutex>> locks;
+  locks.reserve(m_shards.size());
+  for (size_t i = 0; i < m_shards.size(); ++i) {
+    locks.push_back(std::unique_lock<std::mutex>(m_shards[i]->mutex));
+  }
+
+  for (size_t i = 0; i < m_shards.size(); ++i) {
+    m_shards[i]->storage->erase(prefix, isPrefix);
+  }
+}
+
+size_t
+ShardedInMemoryStorage::size() const
+{
+  size_t nPackets = 0;
+  for (size_t i = 0; i < m_shards.size(); ++i) {
+    std::lock_guard<std::mutex> lock(m_shards[i]->mutex);
+    nPackets += m_shards[i]->storage->size();
+  }
+  return nPackets;
+}
+
+size_t
+ShardedInMemoryStorage::getShardOfData(const Name& dataName) const
+{
+  return dataName.getPrefixHash(m_shardPrefixLength) % m_shards.size();
+}
+
+size_t
+ShardedInMemoryStorage::getShardOfPrefix(const Name& name) const
+{
+  size_t nComponents = name.size();
+
+  // a full Name determines the Data Name, however short it is
+  if (nComponents > 0 && name.get(-1).isImplicitSha256Digest()) {
+    return name.getPrefixHash(std::min(m_shardPrefixLength, nComponents - 1)) % m_shards.size();
+  }
+
+  if (nComponents >= m_shardPrefixLength) {
+    return getShardOfData(name);
+  }
+
+  return ALL_SHARDS;
+}
+
+bool
+ShardedInMemoryStorage::isBetterMatch(const Interest& interest,
+                                      const Data& candidate, const Data& best)
+{
+  const Name& candidateName = candidate.getFullName();
+  const Name& bestName = best.getFullName();
+
+  if (interest.getChildSelector() <= 0) {
+    return candidateName < bestName;
+  }
+
+  // rightmost child first, then the leftmost Data packet within that child
+  size_t childIndex = interest.getName().size();
+  BOOST_ASSERT(candidateName.size() > childIndex && bestName.size() > childIndex);
+  int order = candidateName.get(childIndex).compare(bestName.get(childIndex));
+  if (order != 0) {
+    return order > 0;
+  }
+  return candidateName < bestName;
+}
+
+} // namespace util
+} // namespace ndn
@@ -0,0 +1,164 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2014 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_UTIL_SHARDED_IN_MEMORY_STORAGE_HPP
+#define NDN_UTIL_SHARDED_IN_MEMORY_STORAGE_HPP
+
+#include "../common.hpp"
+#include "in-memory-storage.hpp"
+
+#include <mutex>
+
+namespace ndn {
+namespace util {
+
+/**
+ * @brief Thread-safe in-memory storage made of independently locked InMemoryStorage shards
+ *
+ * A Data packet is stored in the shard selected by the hash of the first
+ * shardPrefixLength components of its Name.  A lookup or erase whose Name has at least
+ * that many components (not counting an implicit digest) therefore locks a single shard;
+ * shorter Names have to visit every shard.  shardPrefixLength should be chosen so that
+ * the Interests of the application usually carry that many components, for example
+ * the number of components of an object name without its segment number.
+ *
+ * Each shard applies its own replacement policy and limits, as created by the factory.
+ * find() updates the replacement policy state, so shards are guarded by a mutex rather
+ * than a reader-writer lock.
+ *
+ * All methods can be called from any thread.  Data packets passed to insert() must be
+ * managed by shared_ptr and must not be modified afterwards; returned Data packets are
+ * shared with the storage and must not be modified either.  insert() materializes the
+ * lazily decoded fields of the Data (see Data::wireDecode) before storing it, so that the
+ * const getters of returned packets can be called concurrently.
+ *
+ * Example:
+ *
+ *     ShardedInMemoryStorage storage(8, 3, [] {
+ *         return unique_ptr<InMemoryStorage>(new InMemoryStorageLru(10000));
+ *       });
+ *     ...
+ *     // from any thread
+ *     storage.insert(*data);
+ *     shared_ptr<const Data> found = storage.find(interest);
+ */
+class ShardedInMemoryStorage : noncopyable
+{
+public:
+  typedef function<unique_ptr<InMemoryStorage>()> StorageFactory;
+
+  /**
+   * @brief Create @p nShards shards, each one an InMemoryStorage from @p makeStorage
+   * @param shardPrefixLength number of leading Name components that select the shard
+   */
+  ShardedInMemoryStorage(size_t nShards, size_t shardPrefixLength,
+                         const StorageFactory& makeStorage);
+
+  /**
+   * @brief Insert a Data packet into its shard
+   */
+  void
+  insert(const Data& data);
+
+  /**
+   * @brief Find the best match for @p interest, using the same selection rules as
+   *        InMemoryStorage::find(const Interest&)
+   *
+   * When more than one shard is visited, every shard's best match counts as accessed
+   * for the purpose of the replacement policy.
+   * @return{ the best match, if any; otherwise a null shared_ptr }
+   */
+  shared_ptr<const Data>
+  find(const Interest& interest);
+
+  /**
+   * @brief Find the leftmost Data packet whose full Name starts with @p name
+   * @return{ the match, if any; otherwise a null shared_ptr }
+   */
+  shared_ptr<const Data>
+  find(const Name& name);
+
+  /**
+   * @brief Delete entries by @p prefix, or by the full Name if @p isPrefix is false
+   *
+   * If several shards are involved, they are all locked while erasing, so that
+   * no entry under @p prefix can be inserted into one shard while another is erased.
+   */
+  void
+  erase(const Name& prefix, bool isPrefix = true);
+
+  /**
+   * @return{ number of packets stored in all shards }
+   */
+  size_t
+  size() const;
+
+  size_t
+  getNShards() const
+  {
+    return m_shards.size();
+  }
+
+  size_t
+  getShardPrefixLength() const
+  {
+    return m_shardPrefixLength;
+  }
+
+NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  static const size_t ALL_SHARDS;
+
+  /**
+   * @return{ the shard that stores Data packets named @p dataName }
+   */
+  size_t
+  getShardOfData(const Name& dataName) const;
+
+  /**
+   * @return{ the only shard that may store Data packets matching @p name as a prefix,
+   *          or ALL_SHARDS if they may be stored in any shard }
+   */
+  size_t
+  getShardOfPrefix(const Name& name) const;
+
+private:
+  /**
+   * @brief Check whether @p candidate is a better match for @p interest than @p best,
+   *        both of them being the best matches of their shards
+   */
+  static bool
+  isBetterMatch(const Interest& interest, const Data& candidate, const Data& best);
+
+private:
+  struct Shard
+  {
+    std::mutex mutex;
+    unique_ptr<InMemoryStorage> storage;
+  };
+
+  std::vector<unique_ptr<Shard>> m_shards;
+  size_t m_shardPrefixLength;
+};
+
+} // namespace util
+} // namespace ndn
+
+#endif // NDN_UTIL_SHARDED_IN_MEMORY_STORAGE_HPP
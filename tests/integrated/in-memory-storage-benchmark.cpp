@@ -0,0 +1,98 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2014 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "util/in-memory-storage-persistent.hpp"
+
+#include "boost-test.hpp"
+#include "../unit-tests/test-make-interest-data.hpp"
+
+namespace ndn {
+namespace util {
+
+BOOST_AUTO_TEST_SUITE(UtilInMemoryStorageBenchmark)
+
+/** @brief Compares the hashed exact-name lookup against the ordered lookup
+ *
+ *  Selector-free Interests are served by the hashed index, while an Interest with
+ *  ChildSelector=rightmost, which accepts the same Data, goes through the ordered index.
+ */
+BOOST_AUTO_TEST_CASE(ExactNameLookup)
+{
+  static const size_t N_ENTRIES = 1000000;
+  // Interests are prepared for every N_STRIDE-th entry to keep the memory footprint bounded
+  static const size_t N_STRIDE = 10;
+  static const size_t N_ROUNDS = 10;
+
+  InMemoryStoragePersistent ims;
+  std::vector<Interest> exactInterests;
+  std::vector<Interest> orderedInterests;
+
+  const Name prefix("/benchmark/in-memory-storage/object");
+  for (size_t i = 0; i < N_ENTRIES; ++i) {
+    Name name(prefix);
+    name.appendSegment(i);
+    ims.insert(*makeData(name));
+
+    if (i % N_STRIDE == 0) {
+      exactInterests.push_back(Interest(name));
+      orderedInterests.push_back(Interest(name));
+      orderedInterests.back().setChildSelector(1);
+    }
+  }
+  BOOST_REQUIRE_EQUAL(ims.size(), N_ENTRIES);
+
+  // warm up memoized Name hashes and decoded selectors outside of the timed loops
+  for (size_t i = 0; i < exactInterests.size(); ++i) {
+    BOOST_REQUIRE(static_cast<bool>(ims.find(exactInterests[i])));
+    BOOST_REQUIRE(static_cast<bool>(ims.find(orderedInterests[i])));
+  }
+
+  time::nanoseconds exactDuration = time::nanoseconds::zero();
+  time::nanoseconds orderedDuration = time::nanoseconds::zero();
+  size_t nMismatches = 0;
+
+  for (size_t round = 0; round < N_ROUNDS; ++round) {
+    time::steady_clock::TimePoint t0 = time::steady_clock::now();
+    for (size_t i = 0; i < exactInterests.size(); ++i) {
+      nMismatches += !ims.find(exactInterests[i]);
+    }
+    time::steady_clock::TimePoint t1 = time::steady_clock::now();
+    for (size_t i = 0; i < orderedInterests.size(); ++i) {
+      nMismatches += !ims.find(orderedInterests[i]);
+    }
+    time::steady_clock::TimePoint t2 = time::steady_clock::now();
+
+    exactDuration += time::duration_cast<time::nanoseconds>(t1 - t0);
+    orderedDuration += time::duration_cast<time::nanoseconds>(t2 - t1);
+  }
+  BOOST_CHECK_EQUAL(nMismatches, 0);
+
+  size_t nLookups = exactInterests.size() * N_ROUNDS;
+  BOOST_TEST_MESSAGE("exact-name (hashed) lookup: " <<
+                     exactDuration.count() / nLookups << " ns per Interest");
+  BOOST_TEST_MESSAGE("selector (ordered) lookup: " <<
+                     orderedDuration.count() / nLookups << " ns per Interest");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace util
+} // namespace ndn
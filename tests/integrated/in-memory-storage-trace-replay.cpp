@@ -0,0 +1,217 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2014 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "util/in-memory-storage-persistent.hpp"
+#include "util/in-memory-storage-fifo.hpp"
+#include "util/in-memory-storage-lfu.hpp"
+#include "util/in-memory-storage-lru.hpp"
+#include "util/in-memory-storage-arc.hpp"
+#include "util/in-memory-storage-tinylfu.hpp"
+
+#include "boost-test.hpp"
+#include "../unit-tests/test-make-interest-data.hpp"
+
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_real_distribution.hpp>
+
+namespace ndn {
+namespace util {
+
+BOOST_AUTO_TEST_SUITE(UtilInMemoryStorageTraceReplay)
+
+/** @brief Request trace: the Name of each requested object, in order
+ */
+typedef std::vector<Name> Trace;
+
+static const size_t N_OBJECTS = 10000;
+static const size_t N_REQUESTS = 200000;
+static const size_t CAPACITY = 500;
+
+/** @brief Generates Zipf-distributed object ranks
+ */
+class ZipfGenerator
+{
+public:
+  ZipfGenerator(size_t nObjects, double exponent)
+    : m_cdf(nObjects)
+    , m_random(8778)
+  {
+    double sum = 0;
+    for (size_t rank = 0; rank < nObjects; ++rank) {
+      sum += 1.0 / std::pow(rank + 1, exponent);
+      m_cdf[rank] = sum;
+    }
+    for (size_t rank = 0; rank < nObjects; ++rank) {
+      m_cdf[rank] /= sum;
+    }
+  }
+
+  size_t
+  operator()()
+  {
+    double u = boost::random::uniform_real_distribution<double>(0, 1)(m_random);
+    size_t rank = std::lower_bound(m_cdf.begin(), m_cdf.end(), u) - m_cdf.begin();
+    return std::min(rank, m_cdf.size() - 1);
+  }
+
+private:
+  std::vector<double> m_cdf;
+  boost::random::mt19937 m_random;
+};
+
+static Name
+makeObjectName(const Name& prefix, size_t id)
+{
+  Name name(prefix);
+  name.appendNumber(id);
+  return name;
+}
+
+/** @brief Zipf popularity, interleaved with scans of objects that are requested only once
+ *  @param scanInterval number of popular requests between two scans, 0 disables scans
+ */
+static Trace
+makeZipfTrace(size_t scanInterval, size_t scanLength)
+{
+  ZipfGenerator zipf(N_OBJECTS, 0.9);
+
+  Trace trace;
+  trace.reserve(N_REQUESTS);
+  size_t nScanned = 0;
+  while (trace.size() < N_REQUESTS) {
+    trace.push_back(makeObjectName("/popular", zipf()));
+
+    if (scanInterval > 0 && trace.size() % scanInterval == 0) {
+      for (size_t i = 0; i < scanLength && trace.size() < N_REQUESTS; ++i) {
+        trace.push_back(makeObjectName("/scan", nScanned++));
+      }
+    }
+  }
+  return trace;
+}
+
+/** @brief Zipf popularity whose most popular objects change midway through the trace
+ */
+static Trace
+makeShiftingTrace()
+{
+  ZipfGenerator zipf(N_OBJECTS, 0.9);
+
+  Trace trace;
+  trace.reserve(N_REQUESTS);
+  for (size_t i = 0; i < N_REQUESTS; ++i) {
+    size_t rank = zipf();
+    if (i >= N_REQUESTS / 2)
+      rank = N_OBJECTS - 1 - rank;
+    trace.push_back(makeObjectName("/popular", rank));
+  }
+  return trace;
+}
+
+/** @brief Replays @p trace against @p ims, inserting a Data packet on every miss
+ *  @return{ hit ratio }
+ */
+static double
+replay(InMemoryStorage& ims, const Trace& trace)
+{
+  size_t nHits = 0;
+  for (Trace::const_iterator name = trace.begin(); name != trace.end(); ++name) {
+    if (ims.find(Interest(*name)))
+      ++nHits;
+    else
+      ims.insert(*makeData(*name));
+  }
+  return static_cast<double>(nHits) / trace.size();
+}
+
+struct HitRatios
+{
+  double persistent;
+  double fifo;
+  double lfu;
+  double lru;
+  double arc;
+  double tinyLfu;
+};
+
+static HitRatios
+replayAll(const std::string& traceName, const Trace& trace)
+{
+  HitRatios ratios;
+  {
+    InMemoryStoragePersistent ims;
+    ratios.persistent = replay(ims, trace);
+  }
+  {
+    InMemoryStorageFifo ims(CAPACITY);
+    ratios.fifo = replay(ims, trace);
+  }
+  {
+    InMemoryStorageLfu ims(CAPACITY);
+    ratios.lfu = replay(ims, trace);
+  }
+  {
+    InMemoryStorageLru ims(CAPACITY);
+    ratios.lru = replay(ims, trace);
+  }
+  {
+    InMemoryStorageArc ims(CAPACITY);
+    ratios.arc = replay(ims, trace);
+  }
+  {
+    InMemoryStorageTinyLfu ims(CAPACITY);
+    ratios.tinyLfu = replay(ims, trace);
+  }
+
+  BOOST_TEST_MESSAGE(traceName << " (" << trace.size() << " requests, capacity " <<
+                     CAPACITY << "): hit ratio" <<
+                     " Persistent(unbounded)=" << ratios.persistent <<
+                     " FIFO=" << ratios.fifo <<
+                     " LFU=" << ratios.lfu <<
+                     " LRU=" << ratios.lru <<
+                     " ARC=" << ratios.arc <<
+                     " W-TinyLFU=" << ratios.tinyLfu);
+  return ratios;
+}
+
+BOOST_AUTO_TEST_CASE(Zipf)
+{
+  HitRatios ratios = replayAll("Zipf", makeZipfTrace(0, 0));
+  BOOST_CHECK_GE(ratios.tinyLfu, ratios.lru);
+}
+
+BOOST_AUTO_TEST_CASE(ZipfWithScans)
+{
+  HitRatios ratios = replayAll("Zipf with scans", makeZipfTrace(2000, 2 * CAPACITY));
+  BOOST_CHECK_GT(ratios.arc, ratios.lru);
+  BOOST_CHECK_GT(ratios.tinyLfu, ratios.lru);
+}
+
+BOOST_AUTO_TEST_CASE(ShiftingPopularity)
+{
+  HitRatios ratios = replayAll("Shifting popularity", makeShiftingTrace());
+  BOOST_CHECK_GT(ratios.tinyLfu, ratios.lfu);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace util
+} // namespace ndn
@@ -0,0 +1,120 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2014 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "detail/interest-filter-table.hpp"
+
+#include "boost-test.hpp"
+
+#include <list>
+
+namespace ndn {
+
+BOOST_AUTO_TEST_SUITE(InterestFilterTableBenchmark)
+
+/** @brief Compares InterestFilterTable dispatch against a linear list of filters
+ *
+ *  The linear list is how Face used to keep its filters: every incoming Interest was matched
+ *  against every filter, evaluating regular expressions along the way.
+ */
+BOOST_AUTO_TEST_CASE(Dispatch)
+{
+  static const size_t N_PREFIX_FILTERS = 500;
+  static const size_t N_REGEX_FILTERS = 200;
+  static const size_t N_INTERESTS = 2000;
+  static const size_t N_ROUNDS = 20;
+
+  typedef std::list<shared_ptr<InterestFilterRecord> > FilterList;
+  FilterList list;
+  InterestFilterTable table;
+
+  for (size_t i = 0; i < N_PREFIX_FILTERS + N_REGEX_FILTERS; ++i) {
+    Name prefix("/benchmark/application");
+    prefix.appendNumber(i);
+
+    shared_ptr<InterestFilterRecord> record;
+    if (i < N_PREFIX_FILTERS)
+      record = make_shared<InterestFilterRecord>(InterestFilter(prefix),
+                                                 InterestFilterRecord::OnInterest());
+    else
+      record = make_shared<InterestFilterRecord>(InterestFilter(prefix, "<><>*<%00%01>"),
+                                                 InterestFilterRecord::OnInterest());
+    list.push_back(record);
+    table.insert(record);
+  }
+
+  // two thirds of the Interests match a filter, the others fall under no filter prefix
+  std::vector<Name> names;
+  for (size_t i = 0; i < N_INTERESTS; ++i) {
+    Name name(i % 3 == 2 ? "/benchmark/unrelated" : "/benchmark/application");
+    name.appendNumber(i % (N_PREFIX_FILTERS + N_REGEX_FILTERS))
+        .append("object")
+        .appendVersion(i)
+        .appendSegment(i % 2);
+    names.push_back(name);
+  }
+
+  // the results must agree before anything is timed
+  size_t nMatches = 0;
+  for (size_t i = 0; i < names.size(); ++i) {
+    InterestFilterTable::RecordList expected;
+    for (FilterList::const_iterator j = list.begin(); j != list.end(); ++j) {
+      if ((*j)->doesMatch(names[i]))
+        expected.push_back(*j);
+    }
+    InterestFilterTable::RecordList actual = table.findMatching(names[i]);
+    BOOST_REQUIRE(actual == expected);
+    nMatches += actual.size();
+  }
+  BOOST_REQUIRE_GT(nMatches, 0);
+
+  time::nanoseconds listDuration = time::nanoseconds::zero();
+  time::nanoseconds tableDuration = time::nanoseconds::zero();
+  size_t nListMatches = 0;
+  size_t nTableMatches = 0;
+
+  for (size_t round = 0; round < N_ROUNDS; ++round) {
+    time::steady_clock::TimePoint t0 = time::steady_clock::now();
+    for (size_t i = 0; i < names.size(); ++i) {
+      for (FilterList::const_iterator j = list.begin(); j != list.end(); ++j) {
+        nListMatches += (*j)->doesMatch(names[i]);
+      }
+    }
+    time::steady_clock::TimePoint t1 = time::steady_clock::now();
+    for (size_t i = 0; i < names.size(); ++i) {
+      nTableMatches += table.findMatching(names[i]).size();
+    }
+    time::steady_clock::TimePoint t2 = time::steady_clock::now();
+
+    listDuration += time::duration_cast<time::nanoseconds>(t1 - t0);
+    tableDuration += time::duration_cast<time::nanoseconds>(t2 - t1);
+  }
+  BOOST_CHECK_EQUAL(nListMatches, nTableMatches);
+
+  size_t nDispatches = names.size() * N_ROUNDS;
+  BOOST_TEST_MESSAGE("linear list of " << list.size() << " filters: " <<
+                     listDuration.count() / nDispatches << " ns per Interest");
+  BOOST_TEST_MESSAGE("InterestFilterTable with " << table.size() << " filters: " <<
+                     tableDuration.count() / nDispatches << " ns per Interest");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
@@ -0,0 +1,179 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2014 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "encoding/block-decoder.hpp"
+#include "encoding/block-helpers.hpp"
+
+#include "boost-test.hpp"
+
+#include <boost/iostreams/stream.hpp>
+#include <boost/iostreams/device/array.hpp>
+
+namespace ndn {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(EncodingBlockDecoder)
+
+static const uint8_t WIRE[] = {
+  0x06, 0x03, 0x01, 0x02, 0x03,
+  0x07, 0x00,
+  0xfd, 0x01, 0x00, 0xfd, 0x00, 0x02, 0x41, 0x42
+};
+
+class BlockDecoderFixture
+{
+public:
+  BlockDecoderFixture()
+    : decoder([this] (const Block& element) { elements.push_back(element); })
+  {
+  }
+
+  void
+  checkElements()
+  {
+    BOOST_REQUIRE_EQUAL(elements.size(), 3);
+    BOOST_CHECK_EQUAL(elements[0].type(), 0x06);
+    BOOST_CHECK_EQUAL(elements[0].value_size(), 3);
+    BOOST_CHECK_EQUAL(elements[1].type(), 0x07);
+    BOOST_CHECK_EQUAL(elements[1].value_size(), 0);
+    BOOST_CHECK_EQUAL(elements[2].type(), 0x100);
+    BOOST_CHECK_EQUAL(elements[2].value_size(), 2);
+    BOOST_CHECK_EQUAL_COLLECTIONS(elements[2].begin(), elements[2].end(),
+                                  WIRE + 7, WIRE + sizeof(WIRE));
+  }
+
+public:
+  std::vector<Block> elements;
+  BlockDecoder decoder;
+};
+
+BOOST_FIXTURE_TEST_CASE(SharedBuffer, BlockDecoderFixture)
+{
+  ConstBufferPtr buffer = make_shared<Buffer>(WIRE, sizeof(WIRE));
+
+  decoder.decode(buffer, buffer->begin(), buffer->begin() + 9);
+  BOOST_CHECK_EQUAL(elements.size(), 2);
+  BOOST_CHECK(decoder.hasPendingElement());
+  BOOST_CHECK_EQUAL(decoder.getNeededSize(), 2);
+
+  decoder.decode(buffer, buffer->begin() + 9, buffer->end());
+  BOOST_CHECK(!decoder.hasPendingElement());
+  checkElements();
+
+  // all elements, including the one split across chunks, refer to the buffer
+  for (std::vector<Block>::iterator i = elements.begin(); i != elements.end(); ++i)
+    BOOST_CHECK(i->getBuffer() == buffer);
+}
+
+BOOST_FIXTURE_TEST_CASE(SeparateBuffers, BlockDecoderFixture)
+{
+  ConstBufferPtr first = make_shared<Buffer>(WIRE, 11);
+  ConstBufferPtr second = make_shared<Buffer>(WIRE + 11, sizeof(WIRE) - 11);
+
+  decoder.decode(first, first->begin(), first->end());
+  decoder.decode(second, second->begin(), second->end());
+  checkElements();
+  BOOST_CHECK(elements[0].getBuffer() == first);
+  BOOST_CHECK(elements[2].getBuffer() != first);
+  BOOST_CHECK(elements[2].getBuffer() != second);
+}
+
+BOOST_FIXTURE_TEST_CASE(OctetByOctet, BlockDecoderFixture)
+{
+  for (size_t i = 0; i < sizeof(WIRE); ++i)
+    decoder.decode(WIRE + i, 1);
+  checkElements();
+}
+
+BOOST_FIXTURE_TEST_CASE(NeededSize, BlockDecoderFixture)
+{
+  BOOST_CHECK_EQUAL(decoder.getNeededSize(), 1);
+  decoder.decode(WIRE + 7, 1);
+  BOOST_CHECK_EQUAL(decoder.getNeededSize(), 3);
+  decoder.decode(WIRE + 8, 3);
+  BOOST_CHECK_EQUAL(decoder.getNeededSize(), 2);
+  decoder.decode(WIRE + 11, 2);
+  BOOST_CHECK_EQUAL(decoder.getNeededSize(), 2);
+
+  decoder.reset();
+  BOOST_CHECK(!decoder.hasPendingElement());
+  decoder.decode(WIRE, sizeof(WIRE));
+  checkElements();
+}
+
+BOOST_AUTO_TEST_CASE(MaxElementSize)
+{
+  size_t nElements = 0;
+  BlockDecoder decoder([&nElements] (const Block&) { ++nElements; }, 5);
+
+  decoder.decode(WIRE, 7);
+  BOOST_CHECK_EQUAL(nElements, 2);
+  BOOST_CHECK_THROW(decoder.decode(WIRE + 7, 8), BlockDecoder::Error);
+  BOOST_CHECK(!decoder.hasPendingElement());
+
+  // a bogus TLV-LENGTH is rejected before any value arrives
+  const uint8_t hugeLength[] = {0x06, 0xff, 0x7f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff};
+  BlockDecoder unlimited([] (const Block&) {}, std::numeric_limits<size_t>::max());
+  BOOST_CHECK_NO_THROW(unlimited.decode(hugeLength, sizeof(hugeLength)));
+  BOOST_CHECK(unlimited.hasPendingElement());
+}
+
+BOOST_FIXTURE_TEST_CASE(TypeOutOfRange, BlockDecoderFixture)
+{
+  const uint8_t wire[] = {0xfe, 0xff, 0xff, 0xff, 0xff, 0x00,
+                          0xff, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00};
+  BOOST_CHECK_NO_THROW(decoder.decode(wire, 6));
+  BOOST_CHECK_EQUAL(elements.size(), 1);
+  BOOST_CHECK_THROW(decoder.decode(wire + 6, sizeof(wire) - 6), BlockDecoder::Error);
+}
+
+BOOST_AUTO_TEST_CASE(Stream)
+{
+  std::vector<Block> elements;
+  BlockDecoder decoder([&elements] (const Block& element) { elements.push_back(element); },
+                       std::numeric_limits<size_t>::max());
+
+  // larger than a packet
+  std::vector<uint8_t> wire(3 * MAX_NDN_PACKET_SIZE, 0x42);
+  Block large = dataBlock(0x80, &wire.front(), wire.size());
+  wire.assign(large.begin(), large.end());
+  wire.insert(wire.end(), WIRE, WIRE + 5);
+
+  typedef boost::iostreams::stream<boost::iostreams::array_source> ArrayStream;
+  ArrayStream stream(reinterpret_cast<const char*>(&wire.front()), wire.size() - 1);
+
+  BOOST_CHECK(decoder.decode(stream));
+  BOOST_REQUIRE_EQUAL(elements.size(), 1);
+  BOOST_CHECK(elements[0] == large);
+
+  // only the bytes of the element were extracted
+  BOOST_CHECK_EQUAL(stream.peek(), 0x06);
+
+  BOOST_CHECK(!decoder.decode(stream));
+  BOOST_CHECK_EQUAL(elements.size(), 1);
+  BOOST_CHECK(decoder.hasPendingElement());
+  BOOST_CHECK_EQUAL(decoder.getNeededSize(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace ndn
@@ -0,0 +1,106 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2014 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "encoding/block-view.hpp"
+
+#include "boost-test.hpp"
+
+namespace ndn {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(EncodingBlockView)
+
+static const uint8_t WIRE[] = {
+  0x06, 0x0c,
+        0x07, 0x04,
+              0x08, 0x02, 0x41, 0x42,
+        0x14, 0x00,
+        0x15, 0x02, 0x01, 0x02
+};
+
+BOOST_AUTO_TEST_CASE(Empty)
+{
+  BlockView view;
+  BOOST_CHECK(view.empty());
+  BOOST_CHECK_EQUAL(view.size(), 0);
+  BOOST_CHECK(view.elements_begin() == view.elements_end());
+  BOOST_CHECK(view.toBlock().empty());
+}
+
+BOOST_AUTO_TEST_CASE(Parse)
+{
+  BlockView view(WIRE, sizeof(WIRE));
+  BOOST_CHECK_EQUAL(view.type(), 0x06);
+  BOOST_CHECK(view.wire() == WIRE);
+  BOOST_CHECK_EQUAL(view.size(), sizeof(WIRE));
+  BOOST_CHECK(view.value() == WIRE + 2);
+  BOOST_CHECK_EQUAL(view.value_size(), sizeof(WIRE) - 2);
+
+  std::vector<uint32_t> types;
+  for (BlockView::const_iterator i = view.elements_begin(); i != view.elements_end(); ++i) {
+    types.push_back(i->type());
+  }
+  BOOST_REQUIRE_EQUAL(types.size(), 3);
+  BOOST_CHECK_EQUAL(types[0], 0x07);
+  BOOST_CHECK_EQUAL(types[1], 0x14);
+  BOOST_CHECK_EQUAL(types[2], 0x15);
+
+  BlockView content = view.find(0x15);
+  BOOST_CHECK_EQUAL(content.value_size(), 2);
+  BOOST_CHECK_EQUAL(content.value()[1], 0x02);
+
+  BOOST_CHECK(view.find(0x16).empty());
+}
+
+BOOST_AUTO_TEST_CASE(Malformed)
+{
+  BOOST_CHECK_THROW(BlockView(WIRE, 5), BlockView::Error);
+
+  BlockView view;
+  BOOST_CHECK(!BlockView::fromBuffer(WIRE, 1, view));
+  BOOST_CHECK(view.empty());
+
+  // element whose value is not a sequence of TLV elements
+  static const uint8_t BAD_VALUE[] = {0x06, 0x02, 0x07, 0x04};
+  BlockView bad(BAD_VALUE, sizeof(BAD_VALUE));
+  BOOST_CHECK_THROW(bad.elements_begin(), BlockView::Error);
+}
+
+BOOST_AUTO_TEST_CASE(Materialize)
+{
+  BlockView view(WIRE, sizeof(WIRE));
+
+  Block copy = view.toBlock();
+  BOOST_CHECK(copy.wire() != WIRE);
+  BOOST_CHECK(BlockView(copy) == view);
+
+  ConstBufferPtr buffer = make_shared<Buffer>(WIRE, sizeof(WIRE));
+  BlockView inBuffer(buffer->buf(), buffer->size());
+  Block shared = inBuffer.find(0x07).toBlock(buffer);
+  BOOST_CHECK_EQUAL(shared.type(), 0x07);
+  BOOST_CHECK(shared.wire() == buffer->buf() + 2);
+  BOOST_CHECK_EQUAL(shared.value_size(), 4);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace ndn
@@ -297,6 +297,30 @@ BOOST_AUTO_TEST_CASE(Delete)
   BOOST_CHECK_EQUAL(keyChain.doesIdentityExist(identity), false);
 }
 
+BOOST_AUTO_TEST_CASE(SignWithDeletedCertificate)
+{
+  KeyChain keyChain;
+
+  Name identity("/TestKeyChain/SignWithDeletedCertificate");
+  identity.appendVersion();
+
+  Name certName;
+  BOOST_REQUIRE_NO_THROW(certName = keyChain.createIdentity(identity));
+
+  for (int i = 0; i < 2; ++i) {
+    Data data("/TestKeyChain/SignWithDeletedCertificate/Data");
+    BOOST_REQUIRE_NO_THROW(keyChain.sign(data, certName));
+    BOOST_CHECK_EQUAL(data.getSignature().getKeyLocator().getName(), certName.getPrefix(-1));
+  }
+
+  BOOST_REQUIRE_NO_THROW(keyChain.deleteCertificate(certName));
+
+  Data data("/TestKeyChain/SignWithDeletedCertificate/Data");
+  BOOST_CHECK_THROW(keyChain.sign(data, certName), SecPublicInfo::Error);
+
+  keyChain.deleteIdentity(identity);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace tests
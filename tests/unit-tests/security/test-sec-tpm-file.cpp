@@ -92,6 +92,61 @@ BOOST_AUTO_TEST_CASE(SignVerify)
   tpm.deleteKeyPairInTpm(keyName);
 }
 
+BOOST_AUTO_TEST_CASE(SignWithRegeneratedKey)
+{
+  SecTpmFile tpm;
+
+  Name keyName("/TestSecTpmFile/SignWithRegeneratedKey/ksk-" +
+               boost::lexical_cast<std::string>(time::toUnixTimestamp(time::system_clock::now())));
+  const uint8_t content[] = {0x01, 0x02, 0x03, 0x04};
+
+  // first signature caches the decoded RSA key
+  BOOST_REQUIRE_NO_THROW(tpm.generateKeyPairInTpm(keyName, RsaKeyParams(2048)));
+  BOOST_CHECK_NO_THROW(tpm.signInTpm(content, sizeof(content), keyName, DIGEST_ALGORITHM_SHA256));
+  BOOST_CHECK_NO_THROW(tpm.signInTpm(content, sizeof(content), keyName, DIGEST_ALGORITHM_SHA256));
+
+  tpm.deleteKeyPairInTpm(keyName);
+  BOOST_CHECK_THROW(tpm.signInTpm(content, sizeof(content), keyName, DIGEST_ALGORITHM_SHA256),
+                    SecTpmFile::Error);
+
+  // the cached key must not outlive the key pair it was decoded from
+  BOOST_REQUIRE_NO_THROW(tpm.generateKeyPairInTpm(keyName, EcdsaKeyParams()));
+
+  Block sigBlock;
+  BOOST_CHECK_NO_THROW(sigBlock = tpm.signInTpm(content, sizeof(content),
+                                                keyName, DIGEST_ALGORITHM_SHA256));
+
+  shared_ptr<PublicKey> pubkeyPtr;
+  BOOST_CHECK_NO_THROW(pubkeyPtr = tpm.getPublicKeyFromTpm(keyName));
+  BOOST_CHECK_EQUAL(pubkeyPtr->getKeyType(), KEY_TYPE_ECDSA);
+
+  try
+    {
+      using namespace CryptoPP;
+
+      ECDSA<ECP, SHA256>::PublicKey publicKey;
+      ByteQueue queue;
+      queue.Put(reinterpret_cast<const byte*>(pubkeyPtr->get().buf()), pubkeyPtr->get().size());
+      publicKey.Load(queue);
+
+      uint8_t buffer[64];
+      size_t usedSize = DSAConvertSignatureFormat(buffer, 64, DSA_P1363,
+                                                  sigBlock.value(), sigBlock.value_size(), DSA_DER);
+
+      ECDSA<ECP, SHA256>::Verifier verifier(publicKey);
+      bool result = verifier.VerifyMessage(content, sizeof(content),
+                                           buffer, usedSize);
+
+      BOOST_CHECK_EQUAL(result, true);
+    }
+  catch (CryptoPP::Exception& e)
+    {
+      BOOST_CHECK(false);
+    }
+
+  tpm.deleteKeyPairInTpm(keyName);
+}
+
 BOOST_AUTO_TEST_CASE(RandomGenerator)
 {
   SecTpmFile tpm;
@@ -22,6 +22,8 @@
 
 #include "encoding/encoding-buffer.hpp"
 #include "encoding/buffer-stream.hpp"
+#include "encoding/block-helpers.hpp"
+#include "name.hpp"
 
 #include "boost-test.hpp"
 
@@ -158,6 +160,69 @@ BOOST_AUTO_TEST_CASE(EncodingBufferToBlock)
   BOOST_CHECK_EQUAL(block.value_size(), sizeof(value));
 }
 
+BOOST_AUTO_TEST_CASE(PooledEncodingBuffer)
+{
+  std::vector<Block> blocks;
+  for (uint8_t i = 0; i < 100; ++i) {
+    std::vector<uint8_t> value(i * 10, i);
+
+    EncodingBuffer buffer(encoding::Pooled);
+    prependByteArrayBlock(buffer, 0xe0, value.data(), value.size());
+    blocks.push_back(buffer.block());
+  }
+
+  // later encodings must not overwrite earlier ones
+  for (uint8_t i = 0; i < 100; ++i) {
+    BOOST_REQUIRE_EQUAL(blocks[i].value_size(), i * 10U);
+    BOOST_CHECK(std::count(blocks[i].value_begin(), blocks[i].value_end(), i) == i * 10);
+  }
+
+  // encoding larger than a slab
+  std::vector<uint8_t> large(3 * MAX_NDN_PACKET_SIZE, 0xaa);
+  EncodingBuffer buffer(encoding::Pooled);
+  prependByteArrayBlock(buffer, 0xe1, large.data(), large.size());
+  Block block = buffer.block();
+  BOOST_CHECK_EQUAL(block.value_size(), large.size());
+  BOOST_CHECK(std::equal(large.begin(), large.end(), block.value_begin()));
+}
+
+BOOST_AUTO_TEST_CASE(PooledEncodingBufferAppend)
+{
+  Block first;
+  {
+    EncodingBuffer buffer(encoding::Pooled);
+    prependNonNegativeIntegerBlock(buffer, 0xe0, 1);
+    first = buffer.block();
+  }
+
+  EncodingBuffer buffer(encoding::Pooled);
+  buffer.prependByte(0x01);
+  buffer.appendByte(0x02);
+  buffer.prependVarNumber(2);
+  buffer.prependVarNumber(0xe1);
+
+  Block second = buffer.block();
+  BOOST_CHECK_EQUAL(second.value()[0], 0x01);
+  BOOST_CHECK_EQUAL(second.value()[1], 0x02);
+  BOOST_CHECK_EQUAL(readNonNegativeInteger(first), 1);
+}
+
+BOOST_AUTO_TEST_CASE(PooledEncodingBufferSizeHint)
+{
+  EncodingBuffer buffer(encoding::Pooled, 3);
+  prependNonNegativeIntegerBlock(buffer, 0xe0, 1);
+  Block block = buffer.block();
+  BOOST_CHECK_EQUAL(readNonNegativeInteger(block), 1);
+
+#ifndef NDN_CXX_HAVE_CXX_THREAD_LOCAL
+  // without a slab pool, encodings do not allocate whole slabs
+  BOOST_CHECK_EQUAL(block.getBuffer()->size(), 3);
+
+  Name name("/hello/world");
+  BOOST_CHECK_EQUAL(name.wireEncode().getBuffer()->size(), name.wireEncode().size());
+#endif // NDN_CXX_HAVE_CXX_THREAD_LOCAL
+}
+
 BOOST_AUTO_TEST_CASE(BlockToBuffer)
 {
   shared_ptr<Buffer> buf = make_shared<Buffer>(10);
@@ -230,6 +295,35 @@ BOOST_AUTO_TEST_CASE(FromBuffer)
   BOOST_CHECK(!Block::fromBuffer(TEST_BUFFER + offset, sizeof(TEST_BUFFER) - offset, testBlock));
 }
 
+BOOST_AUTO_TEST_CASE(Parse)
+{
+  std::vector<uint8_t> wire = {0xe0, 0xfd, 0x01, 0x08,
+                               0x01, 0x00,
+                               0xfd, 0x01, 0x00, 0x01, 0xaa,
+                               0x02, 0xfd, 0x00, 0xfd};
+  wire.resize(wire.size() + 253, 0xbb);
+  BOOST_REQUIRE_EQUAL(wire.size(), 4 + 0x108);
+
+  Block block(wire.data(), wire.size());
+  BOOST_REQUIRE_NO_THROW(block.parse());
+  BOOST_REQUIRE_EQUAL(block.elements_size(), 3);
+  BOOST_CHECK_EQUAL(block.elements()[0].type(), 0x01);
+  BOOST_CHECK_EQUAL(block.elements()[0].value_size(), 0);
+  BOOST_CHECK_EQUAL(block.elements()[1].type(), 0x100);
+  BOOST_CHECK_EQUAL(block.elements()[1].value()[0], 0xaa);
+  BOOST_CHECK_EQUAL(block.elements()[2].type(), 0x02);
+  BOOST_CHECK_EQUAL(block.elements()[2].value_size(), 253);
+  BOOST_CHECK_EQUAL(block.elements()[2].size(), 257);
+
+  // the last element is truncated
+  static const uint8_t truncated[] = {0xe0, 0x06,
+                                      0x01, 0x01, 0xaa,
+                                      0x02, 0x02, 0xbb};
+  Block truncatedBlock(truncated, sizeof(truncated));
+  BOOST_CHECK_THROW(truncatedBlock.parse(), tlv::Error);
+  BOOST_CHECK_EQUAL(truncatedBlock.elements_size(), 0);
+}
+
 BOOST_AUTO_TEST_CASE(BlockFromStream)
 {
   const uint8_t TEST_BUFFER[] = {0x00, 0x01, 0xfa, // ok
@@ -248,6 +248,87 @@ BOOST_FIXTURE_TEST_CASE(Decode, TestDataFixture)
   BOOST_REQUIRE_EQUAL(signatureVerified, true);
 }
 
+BOOST_AUTO_TEST_CASE(DecodeThenModify)
+{
+  Data d(Block(Data1, sizeof(Data1)));
+
+  // fields not yet accessed must survive invalidation of the wire encoding
+  d.setContent(Content1, sizeof(Content1) - 1);
+  BOOST_CHECK(!d.hasWire());
+  BOOST_CHECK_EQUAL(d.getName(), Name("/local/ndn/prefix"));
+  BOOST_CHECK_EQUAL(d.getFreshnessPeriod(), time::seconds(10));
+  BOOST_CHECK_EQUAL(d.getSignature().getType(),
+                    static_cast<uint32_t>(Signature::Sha256WithRsa));
+  BOOST_CHECK_EQUAL(d.getSignature().getValue().value_size(), 128U);
+}
+
+BOOST_AUTO_TEST_CASE(DecodeMalformedMetaInfo)
+{
+  Buffer wire(Data1, sizeof(Data1));
+  wire[27] = 0x05; // FreshnessPeriod TLV-LENGTH exceeds MetaInfo
+
+  // MetaInfo is materialized on first access, but checked by wireDecode
+  Data d;
+  BOOST_CHECK_THROW(d.wireDecode(Block(wire.buf(), wire.size())), tlv::Error);
+}
+
+BOOST_AUTO_TEST_CASE(EncodeWithSignatureValue)
+{
+  Data expected(Block(Data1, sizeof(Data1)));
+
+  Data d(expected.getName());
+  d.setFreshnessPeriod(expected.getFreshnessPeriod());
+  d.setContent(expected.getContent());
+  d.setSignature(Signature(expected.getSignature().getInfo()));
+
+  EncodingBuffer encoder(400, 200);
+  d.wireEncode(encoder, true);
+  const uint8_t* unsignedPortion = encoder.buf();
+  const Block& wire = d.wireEncode(encoder, expected.getSignature().getValue());
+
+  // the signed portion must not have been moved
+  BOOST_CHECK(wire.value() == unsignedPortion);
+  BOOST_CHECK_EQUAL_COLLECTIONS(wire.begin(), wire.end(), Data1, Data1 + sizeof(Data1));
+  BOOST_CHECK_EQUAL(wire.elements_size(), 5);
+  BOOST_CHECK_EQUAL(d.getName(), expected.getName());
+  BOOST_CHECK(d.getSignature() == expected.getSignature());
+  BOOST_CHECK(d == expected);
+}
+
+BOOST_AUTO_TEST_CASE(EncodeAroundContent)
+{
+  Data expected(Block(Data1, sizeof(Data1)));
+  const Block& expectedContent = expected.getContent();
+
+  Data d(expected.getName());
+  d.setFreshnessPeriod(expected.getFreshnessPeriod());
+  uint8_t* content = d.allocateContent(expectedContent.value_size());
+  std::copy(expectedContent.value_begin(), expectedContent.value_end(), content);
+  d.setSignature(Signature(expected.getSignature().getInfo()));
+
+  EncodingBuffer encoder(0, 0);
+  BOOST_REQUIRE(d.wireEncodeAroundContent(encoder));
+  const Block& wire = d.wireEncode(encoder, expected.getSignature().getValue());
+
+  // the content must not have been copied
+  BOOST_CHECK(d.getContent().value() == content);
+  BOOST_CHECK(wire.get(tlv::Content).value() == content);
+  BOOST_CHECK_EQUAL_COLLECTIONS(wire.begin(), wire.end(), Data1, Data1 + sizeof(Data1));
+  BOOST_CHECK(d == expected);
+
+  // the previous encoding is still in use, so the buffer cannot be written again
+  Block previousWire = wire;
+  d.setFreshnessPeriod(time::seconds(1));
+  BOOST_CHECK(!d.wireEncodeAroundContent(encoder));
+  BOOST_CHECK(d.wireEncode() != previousWire);
+  BOOST_CHECK_EQUAL_COLLECTIONS(previousWire.begin(), previousWire.end(),
+                                Data1, Data1 + sizeof(Data1));
+
+  // content set otherwise is always copied
+  d.setContent(expectedContent);
+  BOOST_CHECK(!d.wireEncodeAroundContent(encoder));
+}
+
 BOOST_FIXTURE_TEST_CASE(Encode, TestDataFixture)
 {
   // manual data packet creation for now
@@ -147,6 +147,61 @@ BOOST_AUTO_TEST_CASE(Ranges)
                       Exclude::Error);
 }
 
+BOOST_AUTO_TEST_CASE(ExcludeMany)
+{
+  Exclude e;
+  e.excludeRange(name::Component("b"), name::Component("d"));
+  e.excludeOne(name::Component("f"));
+
+  std::vector<name::Component> components;
+  components.push_back(name::Component("e"));
+  components.push_back(name::Component("c"));  // in range [b, d]
+  components.push_back(name::Component("aa"));
+  components.push_back(name::Component("f"));  // already excluded
+  components.push_back(name::Component("a"));
+  components.push_back(name::Component("e"));
+
+  e.excludeOne(components.begin(), components.end());
+  BOOST_CHECK_EQUAL(e.size(), 6);
+  BOOST_CHECK_EQUAL(e.toUri(), "a,b,*,d,e,f,aa");
+
+  Exclude sequential;
+  sequential.excludeRange(name::Component("b"), name::Component("d"));
+  sequential.excludeOne(name::Component("f"));
+  for (std::vector<name::Component>::iterator i = components.begin();
+       i != components.end(); ++i)
+    sequential.excludeOne(*i);
+  BOOST_CHECK_EQUAL(e, sequential);
+}
+
+BOOST_AUTO_TEST_CASE(IsExcluded)
+{
+  // ANY /A /B ANY /C /D
+  const uint8_t EXCLUDE[] = { 0x10, 0x10, 0x13, 0x00, 0x08, 0x01, 0x41, 0x08, 0x01, 0x42,
+                              0x13, 0x00, 0x08, 0x01, 0x43, 0x08, 0x01, 0x44 };
+  Exclude e(Block(EXCLUDE, sizeof(EXCLUDE)));
+  BOOST_CHECK_EQUAL(e.toUri(), "*,A,B,*,C,D");
+
+  BOOST_CHECK(e.isExcluded(name::Component()));
+  BOOST_CHECK(e.isExcluded(name::Component("0")));
+  BOOST_CHECK(e.isExcluded(name::Component("A")));
+  BOOST_CHECK(e.isExcluded(name::Component("B")));
+  BOOST_CHECK(e.isExcluded(name::Component("BB")) == false);
+  BOOST_CHECK(e.isExcluded(name::Component("B0")) == false);
+  BOOST_CHECK(e.isExcluded(name::Component("Bz")) == false);
+  BOOST_CHECK(e.isExcluded(name::Component("C")));
+  BOOST_CHECK(e.isExcluded(name::Component("C0")) == false);
+  BOOST_CHECK(e.isExcluded(name::Component("D")));
+  BOOST_CHECK(e.isExcluded(name::Component("E")) == false);
+
+  // the order of terms in the wire encoding does not matter
+  const uint8_t UNORDERED[] = { 0x10, 0x06, 0x08, 0x01, 0x44, 0x08, 0x01, 0x41 };
+  Exclude unordered(Block(UNORDERED, sizeof(UNORDERED)));
+  BOOST_CHECK_EQUAL(unordered.toUri(), "A,D");
+  BOOST_CHECK(unordered.isExcluded(name::Component("A")));
+  BOOST_CHECK(unordered.isExcluded(name::Component("B")) == false);
+}
+
 BOOST_AUTO_TEST_CASE(Malformed)
 {
   Exclude e1;
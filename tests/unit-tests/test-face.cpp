@@ -82,6 +82,37 @@ BOOST_AUTO_TEST_CASE(ExpressInterestData)
   BOOST_CHECK_EQUAL(face->sentDatas.size(), 0);
 }
 
+BOOST_AUTO_TEST_CASE(ExpressInterestMultipleMatches)
+{
+  std::vector<Name> satisfied;
+  OnData onData = [&] (const Interest& i, const Data& d) { satisfied.push_back(i.getName()); };
+  OnTimeout onTimeout = [] (const Interest&) {};
+
+  face->expressInterest(Interest("/Hello/World/!", time::milliseconds(50)), onData, onTimeout);
+  face->expressInterest(Interest("/Hello", time::milliseconds(50)), onData, onTimeout);
+  face->expressInterest(Interest("/Hello/World/!/2", time::milliseconds(50)), onData, onTimeout);
+  face->expressInterest(Interest("/Hello/World", time::milliseconds(50))
+                          .setMaxSuffixComponents(1),
+                        onData, onTimeout);
+  face->expressInterest(Interest("/Hello/World", time::milliseconds(50)), onData, onTimeout);
+
+  advanceClocks(time::milliseconds(10));
+  BOOST_CHECK_EQUAL(face->getNPendingInterests(), 5);
+
+  face->receive(*util::makeData("/Hello/World/!"));
+  advanceClocks(time::milliseconds(10));
+
+  // matching Interests are satisfied in the order they were expressed
+  BOOST_REQUIRE_EQUAL(satisfied.size(), 3);
+  BOOST_CHECK_EQUAL(satisfied[0], Name("/Hello/World/!"));
+  BOOST_CHECK_EQUAL(satisfied[1], Name("/Hello"));
+  BOOST_CHECK_EQUAL(satisfied[2], Name("/Hello/World"));
+  BOOST_CHECK_EQUAL(face->getNPendingInterests(), 2);
+
+  advanceClocks(time::milliseconds(10), 100);
+  BOOST_CHECK_EQUAL(face->getNPendingInterests(), 0);
+}
+
 BOOST_AUTO_TEST_CASE(ExpressInterestTimeout)
 {
   size_t nTimeouts = 0;
@@ -257,6 +288,43 @@ BOOST_AUTO_TEST_CASE(SimilarFilters)
   BOOST_CHECK_EQUAL(nInInterests3, 0);
 }
 
+BOOST_AUTO_TEST_CASE(ManyFilters)
+{
+  std::vector<size_t> nInInterests(100, 0);
+  std::vector<const InterestFilterId*> filterIds;
+  for (size_t i = 0; i < nInInterests.size(); ++i) {
+    filterIds.push_back(
+      face->setInterestFilter(Name("/Hello").appendNumber(i),
+                              bind([&nInInterests, i] { ++nInInterests[i]; })));
+  }
+
+  size_t nRegexInInterests = 0;
+  face->setInterestFilter(InterestFilter(Name("/Hello").appendNumber(42), "<a><>*"),
+                          bind([&nRegexInInterests] { ++nRegexInInterests; }));
+
+  advanceClocks(time::milliseconds(10), 10);
+
+  face->receive(Interest(Name("/Hello").appendNumber(42).append("a").append("b")));
+  face->receive(Interest(Name("/Hello").appendNumber(42).append("c")));
+  face->receive(Interest(Name("/Hello").appendNumber(7)));
+  face->receive(Interest("/Hello"));
+
+  BOOST_CHECK_EQUAL(nInInterests[42], 2);
+  BOOST_CHECK_EQUAL(nInInterests[7], 1);
+  size_t nTotalInInterests = 0;
+  for (size_t i = 0; i < nInInterests.size(); ++i)
+    nTotalInInterests += nInInterests[i];
+  BOOST_CHECK_EQUAL(nTotalInInterests, 3);
+  BOOST_CHECK_EQUAL(nRegexInInterests, 1);
+
+  face->unsetInterestFilter(filterIds[42]);
+  advanceClocks(time::milliseconds(10), 10);
+
+  face->receive(Interest(Name("/Hello").appendNumber(42).append("a")));
+  BOOST_CHECK_EQUAL(nInInterests[42], 2);
+  BOOST_CHECK_EQUAL(nRegexInInterests, 2);
+}
+
 BOOST_AUTO_TEST_CASE(SetRegexFilterError)
 {
   face->setInterestFilter(InterestFilter("/Hello/World", "<><b><c>?"),
@@ -286,6 +286,30 @@ BOOST_AUTO_TEST_CASE(Decode)
   BOOST_CHECK_EQUAL(i.getNonce(), 1U);
 }
 
+BOOST_AUTO_TEST_CASE(DecodeThenModifySelectors)
+{
+  Interest i(Block(Interest1, sizeof(Interest1)));
+
+  i.setMustBeFresh(true);
+  BOOST_CHECK_EQUAL(i.getMinSuffixComponents(), 1);
+  BOOST_CHECK_EQUAL(i.getChildSelector(), 1);
+  BOOST_CHECK_EQUAL(i.getExclude().toUri(), "alex,xxxx,*,yyyy");
+
+  Interest decoded(i.wireEncode());
+  BOOST_CHECK_EQUAL(decoded.getMustBeFresh(), true);
+  BOOST_CHECK(decoded.getSelectors() == i.getSelectors());
+}
+
+BOOST_AUTO_TEST_CASE(DecodeMalformedSelectors)
+{
+  Buffer wire(Interest1, sizeof(Interest1));
+  wire[64] = 0x07; // second Exclude component is not a NameComponent
+
+  // Selectors are materialized on first access, but checked by wireDecode
+  Interest i;
+  BOOST_CHECK_THROW(i.wireDecode(Block(wire.buf(), wire.size())), tlv::Error);
+}
+
 BOOST_AUTO_TEST_CASE(DecodeFromStream)
 {
   boost::iostreams::stream<boost::iostreams::array_source> is(
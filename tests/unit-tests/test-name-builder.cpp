@@ -0,0 +1,81 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2014 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "name-builder.hpp"
+
+#include "boost-test.hpp"
+
+namespace ndn {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(TestNameBuilder)
+
+BOOST_AUTO_TEST_CASE(Basic)
+{
+  Name prefix("/hello/world");
+  NameBuilder builder(prefix);
+  BOOST_CHECK_EQUAL(builder.getPrefix(), prefix);
+
+  Name name = builder.appendSegment(258);
+  BOOST_CHECK(name.hasWire());
+  BOOST_CHECK_EQUAL(name, Name(prefix).appendSegment(258));
+  BOOST_CHECK(name.wireEncode() == Name(prefix).appendSegment(258).wireEncode());
+  BOOST_CHECK_EQUAL(name[-1].toSegment(), 258);
+
+  BOOST_CHECK_EQUAL(builder.appendVersion(1), Name(prefix).appendVersion(1));
+  BOOST_CHECK_EQUAL(builder.appendNumber(70000), Name(prefix).appendNumber(70000));
+  BOOST_CHECK_EQUAL(builder.appendNumberWithMarker(0xFE, 3),
+                    Name(prefix).appendNumberWithMarker(0xFE, 3));
+  BOOST_CHECK_EQUAL(builder.append(name::Component("A")), Name(prefix).append("A"));
+
+  // component without wire encoding
+  name::Component component(Block(tlv::NameComponent, make_shared<Buffer>(2)));
+  BOOST_CHECK_EQUAL(builder.append(component), Name(prefix).append(component));
+
+  // the prefix is not affected
+  BOOST_CHECK_EQUAL(builder.getPrefix(), prefix);
+}
+
+BOOST_AUTO_TEST_CASE(EmptyPrefix)
+{
+  NameBuilder builder;
+  BOOST_CHECK_EQUAL(builder.appendSegment(0), Name().appendSegment(0));
+  BOOST_CHECK(builder.appendSegment(0).wireEncode() == Name().appendSegment(0).wireEncode());
+}
+
+BOOST_AUTO_TEST_CASE(ManyNames)
+{
+  NameBuilder builder("/A");
+
+  std::vector<Name> names;
+  for (uint64_t i = 0; i < 2000; ++i)
+    names.push_back(builder.appendSegment(i));
+
+  for (uint64_t i = 0; i < 2000; ++i) {
+    BOOST_REQUIRE_EQUAL(names[i].size(), 2);
+    BOOST_CHECK_EQUAL(names[i][-1].toSegment(), i);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace ndn
@@ -0,0 +1,152 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2014 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "name-view.hpp"
+
+#include "boost-test.hpp"
+
+namespace ndn {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(TestNameView)
+
+BOOST_AUTO_TEST_CASE(Basic)
+{
+  Name name("/hello/world/%00%01");
+  NameView view(name);
+
+  BOOST_CHECK_EQUAL(view.size(), 3);
+  BOOST_CHECK(!view.empty());
+  BOOST_CHECK_EQUAL(view.toName(), name);
+
+  NameView::const_iterator i = view.begin();
+  BOOST_CHECK_EQUAL(std::string(reinterpret_cast<const char*>(i->value()), i->value_size()),
+                    "hello");
+
+  BOOST_CHECK(NameView(Name()).empty());
+  BOOST_CHECK_EQUAL(NameView().size(), 0);
+  static const uint8_t DATA[] = {0x06, 0x00};
+  BOOST_CHECK_THROW(NameView(BlockView(DATA, sizeof(DATA))), tlv::Error);
+}
+
+BOOST_AUTO_TEST_CASE(IsPrefixOf)
+{
+  Name a("/a/b");
+  Name ab("/a/b/c");
+  Name other("/a/bc");
+
+  BOOST_CHECK(NameView(a).isPrefixOf(NameView(ab)));
+  BOOST_CHECK(NameView(a).isPrefixOf(NameView(a)));
+  BOOST_CHECK(NameView(Name()).isPrefixOf(NameView(a)));
+  BOOST_CHECK(!NameView(ab).isPrefixOf(NameView(a)));
+  BOOST_CHECK(!NameView(a).isPrefixOf(NameView(other)));
+
+  BOOST_CHECK(NameView(a) == NameView(Name("/a/b")));
+  BOOST_CHECK(NameView(a) != NameView(ab));
+}
+
+BOOST_AUTO_TEST_CASE(NonMinimalEncoding)
+{
+  // /a/bc with 3-byte TLV-LENGTH of the second component
+  static const uint8_t WIRE[] = {
+    0x07, 0x09,
+      0x08, 0x01, 0x61,
+      0x08, 0xfd, 0x00, 0x02, 0x62, 0x63
+  };
+  NameView view(BlockView(WIRE, sizeof(WIRE)));
+
+  BOOST_CHECK(view == NameView(Name("/a/bc")));
+  BOOST_CHECK(NameView(Name("/a/bc")).isPrefixOf(view));
+  BOOST_CHECK(view.isPrefixOf(NameView(Name("/a/bc/d"))));
+  BOOST_CHECK(!view.isPrefixOf(NameView(Name("/a/bd"))));
+  BOOST_CHECK_EQUAL(view.compare(NameView(Name("/a/bc"))), 0);
+  BOOST_CHECK_EQUAL(view.getHash(), Name("/a/bc").getHash());
+}
+
+BOOST_AUTO_TEST_CASE(Hash)
+{
+  Name name("/hello/world/%00%01");
+  NameView view(name);
+
+  BOOST_CHECK_EQUAL(NameView().getHash(), Name().getHash());
+  BOOST_CHECK_EQUAL(view.getHash(), name.getHash());
+
+  size_t prefixHash = 0;
+  size_t prefixSize = 0;
+  for (NameView::const_iterator i = view.begin(); i != view.end(); ++i) {
+    prefixHash = NameView::combineHash(prefixHash, *i);
+    ++prefixSize;
+    BOOST_CHECK_EQUAL(prefixHash, name.getPrefixHash(prefixSize));
+    BOOST_CHECK_EQUAL(view.getPrefix(prefixSize).getHash(), prefixHash);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(GetPrefix)
+{
+  Name name("/a/b/c");
+  NameView view(name);
+
+  BOOST_CHECK(view.getPrefix(0).empty());
+  BOOST_CHECK_EQUAL(view.getPrefix(0).toName(), Name());
+  BOOST_CHECK_EQUAL(view.getPrefix(2).size(), 2);
+  BOOST_CHECK_EQUAL(view.getPrefix(2).toName(), Name("/a/b"));
+  BOOST_CHECK(view.getPrefix(2) == NameView(Name("/a/b")));
+  BOOST_CHECK(view.getPrefix(2).isPrefixOf(view));
+  BOOST_CHECK(!view.isPrefixOf(view.getPrefix(2)));
+  BOOST_CHECK(view.getPrefix(5) == view);
+
+  size_t nPrefixes = 0;
+  for (NameView::const_iterator i = view.begin(); ; ++i) {
+    BOOST_CHECK_EQUAL(view.getPrefix(i).toName(), name.getPrefix(nPrefixes));
+    ++nPrefixes;
+    if (i == view.end())
+      break;
+  }
+  BOOST_CHECK_EQUAL(nPrefixes, 4);
+}
+
+BOOST_AUTO_TEST_CASE(Compare)
+{
+  std::vector<Name> names;
+  names.push_back(Name("/"));
+  names.push_back(Name("/a"));
+  names.push_back(Name("/a/b"));
+  names.push_back(Name("/b"));
+  names.push_back(Name("/aa"));
+  names.push_back(Name("/%00%01"));
+  names.push_back(Name("/a").appendVersion(1));
+  names.push_back(Name("/a").appendVersion(300));
+  names.push_back(Name("/a/b/c"));
+
+  for (size_t i = 0; i < names.size(); ++i) {
+    for (size_t j = 0; j < names.size(); ++j) {
+      int expected = names[i].compare(names[j]);
+      int actual = NameView(names[i]).compare(NameView(names[j]));
+      BOOST_CHECK_EQUAL(expected < 0, actual < 0);
+      BOOST_CHECK_EQUAL(expected == 0, actual == 0);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace ndn
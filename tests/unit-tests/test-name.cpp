@@ -322,6 +322,53 @@ BOOST_AUTO_TEST_CASE(UnorderedMap)
   BOOST_CHECK_EQUAL(map[name3], 3);
 }
 
+BOOST_AUTO_TEST_CASE(Hash)
+{
+  Name name("/hello/world/A");
+  BOOST_CHECK_EQUAL(name.getHash(), Name("/hello/world/A").getHash());
+  BOOST_CHECK_EQUAL(name.getHash(), std::hash<Name>()(name));
+  BOOST_CHECK_NE(name.getHash(), Name("/hello/world/B").getHash());
+
+  for (ssize_t i = 0; i <= 3; ++i) {
+    BOOST_CHECK_EQUAL(name.getPrefixHash(i), name.getPrefix(i).getHash());
+  }
+  BOOST_CHECK_EQUAL(name.getPrefixHash(-1), Name("/hello/world").getHash());
+  BOOST_CHECK_EQUAL(name.getPrefixHash(10), name.getHash());
+  BOOST_CHECK_THROW(name.getPrefixHash(-4), Name::Error);
+
+  // same components, different types
+  Name digest;
+  digest.appendImplicitSha256Digest(make_shared<Buffer>(32));
+  Name generic;
+  generic.append(digest[0].value(), digest[0].value_size());
+  Name longer = generic;
+  longer.append("x");
+  BOOST_CHECK(digest == generic);
+  BOOST_CHECK(digest.isPrefixOf(longer));
+  BOOST_CHECK_NE(digest.compare(generic), 0);
+
+  // equality does not depend on whether hash values have been computed
+  BOOST_CHECK_NE(digest.getHash(), generic.getHash());
+  longer.getHash();
+  BOOST_CHECK(digest == generic);
+  BOOST_CHECK(digest.isPrefixOf(longer));
+
+  // cached hash values must follow modifications
+  size_t hash = name.getHash();
+  name.append("B");
+  BOOST_CHECK_EQUAL(name.getHash(), Name("/hello/world/A/B").getHash());
+  BOOST_CHECK_EQUAL(name.getPrefixHash(3), hash);
+
+  name.clear();
+  BOOST_CHECK_EQUAL(name.getHash(), Name().getHash());
+
+  name.wireDecode(Name("/hello/world/B").wireEncode());
+  BOOST_CHECK_EQUAL(name.getHash(), Name("/hello/world/B").getHash());
+  BOOST_CHECK(name == Name("/hello/world/B"));
+  BOOST_CHECK(Name("/hello").isPrefixOf(name));
+  BOOST_CHECK(!Name("/hello/world/A").isPrefixOf(name));
+}
+
 BOOST_AUTO_TEST_CASE(ImplictSha256Digest)
 {
   Name n;
@@ -0,0 +1,128 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2014 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "transport/transport.hpp"
+#include "encoding/block-helpers.hpp"
+
+#include "boost-test.hpp"
+
+namespace ndn {
+
+class QueueingTransport : public Transport
+{
+public:
+  virtual void
+  close()
+  {
+    resetSendQueueSize();
+  }
+
+  virtual void
+  pause()
+  {
+  }
+
+  virtual void
+  resume()
+  {
+  }
+
+  virtual void
+  send(const Block& wire)
+  {
+    updateSendQueueSize(getSendQueueSize() + wire.size());
+  }
+
+  virtual void
+  send(const Block& header, const Block& payload)
+  {
+    updateSendQueueSize(getSendQueueSize() + header.size() + payload.size());
+  }
+
+  void
+  drain(size_t nBytes)
+  {
+    updateSendQueueSize(getSendQueueSize() - nBytes);
+  }
+};
+
+BOOST_AUTO_TEST_SUITE(TransportTestTransport)
+
+BOOST_AUTO_TEST_CASE(SendQueueHighWaterMark)
+{
+  QueueingTransport transport;
+  BOOST_CHECK_EQUAL(transport.getSendQueueHighWaterMark(),
+                    Transport::DEFAULT_SEND_QUEUE_HIGH_WATER_MARK);
+
+  size_t nFull = 0;
+  size_t nDrained = 0;
+  transport.onSendQueueFull.connect([&nFull] { ++nFull; });
+  transport.onSendQueueDrained.connect([&nDrained] { ++nDrained; });
+
+  transport.setSendQueueHighWaterMark(1000);
+
+  Block block = dataBlock(tlv::Content, std::string(396, 'x').data(), 396); // 400 octets
+  transport.send(block);
+  transport.send(block);
+  BOOST_CHECK_EQUAL(transport.getSendQueueSize(), 800);
+  BOOST_CHECK_EQUAL(transport.isSendQueueFull(), false);
+  BOOST_CHECK_EQUAL(nFull, 0);
+
+  transport.send(block);
+  transport.send(block, block);
+  BOOST_CHECK_EQUAL(transport.isSendQueueFull(), true);
+  BOOST_CHECK_EQUAL(nFull, 1);
+
+  transport.drain(800);
+  BOOST_CHECK_EQUAL(transport.isSendQueueFull(), true);
+  BOOST_CHECK_EQUAL(nDrained, 0);
+
+  transport.drain(800);
+  BOOST_CHECK_EQUAL(transport.getSendQueueSize(), 400);
+  BOOST_CHECK_EQUAL(transport.isSendQueueFull(), false);
+  BOOST_CHECK_EQUAL(nDrained, 1);
+
+  transport.setSendQueueHighWaterMark(400);
+  BOOST_CHECK_EQUAL(transport.isSendQueueFull(), true);
+  BOOST_CHECK_EQUAL(nFull, 2);
+}
+
+BOOST_AUTO_TEST_CASE(CloseWithFullSendQueue)
+{
+  QueueingTransport transport;
+  transport.setSendQueueHighWaterMark(1000);
+
+  size_t nDrained = 0;
+  transport.onSendQueueDrained.connect([&nDrained] { ++nDrained; });
+
+  Block block = dataBlock(tlv::Content, std::string(996, 'x').data(), 996); // 1000 octets
+  transport.send(block);
+  BOOST_CHECK_EQUAL(transport.isSendQueueFull(), true);
+
+  transport.close();
+  BOOST_CHECK_EQUAL(transport.getSendQueueSize(), 0);
+  BOOST_CHECK_EQUAL(transport.isSendQueueFull(), false);
+  BOOST_CHECK_EQUAL(nDrained, 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
@@ -0,0 +1,190 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2014 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "util/face-pool.hpp"
+#include "transport/transport.hpp"
+
+#include "boost-test.hpp"
+
+#include <set>
+
+namespace ndn {
+namespace util {
+namespace tests {
+
+class CountingTransport : public ndn::Transport
+{
+public:
+  explicit
+  CountingTransport(std::atomic<size_t>& nSentPackets)
+    : m_nSentPackets(nSentPackets)
+  {
+  }
+
+  virtual void
+  close()
+  {
+    m_isConnected = false;
+  }
+
+  virtual void
+  pause()
+  {
+  }
+
+  virtual void
+  resume()
+  {
+  }
+
+  virtual void
+  send(const Block& wire)
+  {
+    ++m_nSentPackets;
+  }
+
+  virtual void
+  send(const Block& header, const Block& payload)
+  {
+    ++m_nSentPackets;
+  }
+
+private:
+  std::atomic<size_t>& m_nSentPackets;
+};
+
+/**
+ * @brief Records the Name and Nonce of every Interest sent through it
+ */
+class RecordingTransport : public ndn::Transport
+{
+public:
+  struct Record
+  {
+    std::mutex mutex;
+    std::set<Name> names;
+    std::set<uint32_t> nonces;
+  };
+
+  explicit
+  RecordingTransport(Record& record)
+    : m_record(record)
+  {
+  }
+
+  virtual void
+  close()
+  {
+    m_isConnected = false;
+  }
+
+  virtual void
+  pause()
+  {
+  }
+
+  virtual void
+  resume()
+  {
+  }
+
+  virtual void
+  send(const Block& wire)
+  {
+    Interest interest(wire);
+
+    std::lock_guard<std::mutex> lock(m_record.mutex);
+    m_record.names.insert(interest.getName());
+    m_record.nonces.insert(interest.getNonce());
+  }
+
+  virtual void
+  send(const Block& header, const Block& payload)
+  {
+  }
+
+private:
+  Record& m_record;
+};
+
+BOOST_AUTO_TEST_SUITE(UtilFacePool)
+
+BOOST_AUTO_TEST_CASE(ExpressFromManyThreads)
+{
+  std::atomic<size_t> nSentPackets(0);
+  FacePool pool(4, [&nSentPackets] { return make_shared<CountingTransport>(ref(nSentPackets)); });
+  BOOST_CHECK_EQUAL(pool.size(), 4);
+
+  pool.start();
+
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < 8; ++i) {
+    threads.push_back(std::thread([&pool, i] {
+      for (size_t j = 0; j < 100; ++j) {
+        pool.expressInterest(Interest(Name("/pool").appendNumber(i).appendNumber(j),
+                                      time::seconds(10)),
+                             OnData());
+      }
+    }));
+  }
+  for (size_t i = 0; i < threads.size(); ++i) {
+    threads[i].join();
+  }
+
+  pool.stop();
+
+  BOOST_CHECK_EQUAL(nSentPackets.load(), 800);
+}
+
+BOOST_AUTO_TEST_CASE(NoncesFromManyThreads)
+{
+  RecordingTransport::Record record;
+  FacePool pool(4, [&record] { return make_shared<RecordingTransport>(ref(record)); });
+
+  pool.start();
+
+  // every thread encodes its Interests, and so draws their nonces, concurrently
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < 8; ++i) {
+    threads.push_back(std::thread([&pool, i] {
+      for (size_t j = 0; j < 100; ++j) {
+        pool.expressInterest(Interest(Name("/nonce").appendNumber(i).appendNumber(j),
+                                      time::seconds(10)),
+                             OnData());
+      }
+    }));
+  }
+  for (size_t i = 0; i < threads.size(); ++i) {
+    threads[i].join();
+  }
+
+  pool.stop();
+
+  BOOST_CHECK_EQUAL(record.names.size(), 800);
+  // generators seeded alike in every thread would repeat the same nonces
+  BOOST_CHECK_GT(record.nonces.size(), 790);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace util
+} // namespace ndn
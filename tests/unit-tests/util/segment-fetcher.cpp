@@ -233,6 +233,30 @@ BOOST_FIXTURE_TEST_CASE(Triple, Fixture)
   }
 }
 
+BOOST_FIXTURE_TEST_CASE(VerifyOncePerSegment, Fixture)
+{
+  size_t nVerified = 0;
+  SegmentFetcher::fetch(*face, Interest("/hello/world", time::seconds(1000)),
+                        [&nVerified] (const Data&) { ++nVerified; return true; },
+                        bind(&Fixture::onData, this, _1),
+                        bind(&Fixture::onError, this, _1));
+
+  advanceClocks(time::milliseconds(1), 10);
+  face->receive(*makeData("/hello/world/version0", 0, false));
+
+  advanceClocks(time::milliseconds(1), 10);
+  face->receive(*makeData("/hello/world/version0", 1, false));
+
+  advanceClocks(time::milliseconds(1), 10);
+  face->receive(*makeData("/hello/world/version0", 2, true));
+
+  advanceClocks(time::milliseconds(1), 10);
+
+  BOOST_CHECK_EQUAL(nErrors, 0);
+  BOOST_CHECK_EQUAL(nDatas, 1);
+  BOOST_CHECK_EQUAL(nVerified, 3);
+}
+
 BOOST_FIXTURE_TEST_CASE(TripleWithInitialSegmentFetching, Fixture)
 {
   SegmentFetcher::fetch(*face, Interest("/hello/world", time::seconds(1000)),
@@ -291,6 +315,94 @@ BOOST_FIXTURE_TEST_CASE(TripleWithInitialSegmentFetching, Fixture)
   }
 }
 
+BOOST_FIXTURE_TEST_CASE(PipelinedOutOfOrder, Fixture)
+{
+  SegmentFetcher::fetch(*face, Interest("/hello/world", time::seconds(1000)),
+                        DontVerifySegment(),
+                        bind(&Fixture::onData, this, _1),
+                        bind(&Fixture::onError, this, _1),
+                        SegmentFetcher::Options());
+
+  advanceClocks(time::milliseconds(1), 10);
+  face->receive(*makeData("/hello/world/version0", 0, false));
+
+  advanceClocks(time::milliseconds(1), 10);
+  BOOST_REQUIRE_EQUAL(face->sentInterests.size(), 3);
+  BOOST_CHECK_EQUAL(face->sentInterests[1].getName(), "/hello/world/version0/%00%01");
+  BOOST_CHECK_EQUAL(face->sentInterests[2].getName(), "/hello/world/version0/%00%02");
+
+  face->receive(*makeData("/hello/world/version0", 2, true));
+  advanceClocks(time::milliseconds(1), 10);
+  BOOST_CHECK_EQUAL(nDatas, 0);
+
+  face->receive(*makeData("/hello/world/version0", 1, false));
+  advanceClocks(time::milliseconds(1), 10);
+
+  BOOST_CHECK_EQUAL(nErrors, 0);
+  BOOST_CHECK_EQUAL(nDatas, 1);
+  BOOST_CHECK_EQUAL(dataSize, 42);
+  BOOST_CHECK_EQUAL(face->sentInterests.size(), 3);
+}
+
+BOOST_FIXTURE_TEST_CASE(PipelinedRetransmission, Fixture)
+{
+  SegmentFetcher::Options options;
+  options.maxRetries = 1;
+
+  SegmentFetcher::fetch(*face, Interest("/hello/world", time::seconds(1000)),
+                        DontVerifySegment(),
+                        bind(&Fixture::onData, this, _1),
+                        bind(&Fixture::onError, this, _1),
+                        options);
+
+  advanceClocks(time::milliseconds(10), 1);
+  face->receive(*makeData("/hello/world/version0", 0, false));
+  advanceClocks(time::milliseconds(1), 1);
+  BOOST_REQUIRE_EQUAL(face->sentInterests.size(), 3);
+  BOOST_CHECK_EQUAL(face->sentInterests[1].getInterestLifetime(), options.minRto);
+
+  // both segments time out; the window drops back to one segment
+  advanceClocks(time::milliseconds(10), 50);
+  BOOST_REQUIRE_EQUAL(face->sentInterests.size(), 4);
+  BOOST_CHECK_EQUAL(face->sentInterests[3].getName(), "/hello/world/version0/%00%01");
+  BOOST_CHECK_EQUAL(face->sentInterests[3].getInterestLifetime(), 2 * options.minRto);
+
+  face->receive(*makeData("/hello/world/version0", 1, false));
+  advanceClocks(time::milliseconds(1), 1);
+  BOOST_REQUIRE_EQUAL(face->sentInterests.size(), 6);
+  BOOST_CHECK_EQUAL(face->sentInterests[4].getName(), "/hello/world/version0/%00%02");
+  BOOST_CHECK_EQUAL(face->sentInterests[5].getName(), "/hello/world/version0/%00%03");
+
+  face->receive(*makeData("/hello/world/version0", 2, true));
+  advanceClocks(time::milliseconds(10), 100);
+
+  BOOST_CHECK_EQUAL(nErrors, 0);
+  BOOST_CHECK_EQUAL(nDatas, 1);
+  BOOST_CHECK_EQUAL(dataSize, 42);
+  BOOST_CHECK_EQUAL(face->sentInterests.size(), 6);
+}
+
+BOOST_FIXTURE_TEST_CASE(PipelinedRetriesExhausted, Fixture)
+{
+  SegmentFetcher::Options options;
+  options.maxRetries = 2;
+
+  SegmentFetcher::fetch(*face, Interest("/hello/world", time::seconds(1000)),
+                        DontVerifySegment(),
+                        bind(&Fixture::onData, this, _1),
+                        bind(&Fixture::onError, this, _1),
+                        options);
+
+  advanceClocks(time::milliseconds(10), 1);
+  face->receive(*makeData("/hello/world/version0", 0, false));
+
+  advanceClocks(time::milliseconds(100), 50);
+
+  BOOST_CHECK_EQUAL(nErrors, 1);
+  BOOST_CHECK_EQUAL(lastError, static_cast<uint32_t>(SegmentFetcher::INTEREST_TIMEOUT));
+  BOOST_CHECK_EQUAL(nDatas, 0);
+}
+
 
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -0,0 +1,159 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2014 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "util/segment-sink.hpp"
+
+#include "boost-test.hpp"
+
+#include <boost/filesystem.hpp>
+#include <csignal>
+#include <fcntl.h>
+#include <fstream>
+#include <iterator>
+#include <sys/resource.h>
+#include <sys/stat.h>
+
+namespace ndn {
+namespace util {
+namespace tests {
+
+class SinkFixture
+{
+public:
+  SinkFixture()
+    : path((boost::filesystem::temp_directory_path() /
+            boost::filesystem::unique_path()).string())
+  {
+    for (size_t i = 0; i < 10000; ++i) {
+      content.push_back(static_cast<uint8_t>(i * 7));
+    }
+  }
+
+  ~SinkFixture()
+  {
+    boost::filesystem::remove(path);
+  }
+
+  /**
+   * @brief Write content in chunks of varying sizes
+   */
+  void
+  writeContent(SegmentSink& sink)
+  {
+    size_t offset = 0;
+    for (size_t chunkSize = 1; offset < content.size(); chunkSize = chunkSize * 3 + 1) {
+      chunkSize = std::min(chunkSize, content.size() - offset);
+      sink.write(content.data() + offset, chunkSize);
+      offset += chunkSize;
+    }
+  }
+
+  std::vector<uint8_t>
+  readFile() const
+  {
+    std::ifstream is(path.c_str(), std::ios::binary);
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(is),
+                                std::istreambuf_iterator<char>());
+  }
+
+public:
+  std::string path;
+  std::vector<uint8_t> content;
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilSegmentSink, SinkFixture)
+
+BOOST_AUTO_TEST_CASE(FileDescriptor)
+{
+  int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  BOOST_REQUIRE(fd >= 0);
+
+  FileDescriptorSink sink(fd);
+  writeContent(sink);
+  sink.finish();
+  ::close(fd);
+
+  std::vector<uint8_t> written = readFile();
+  BOOST_CHECK_EQUAL_COLLECTIONS(written.begin(), written.end(), content.begin(), content.end());
+}
+
+BOOST_AUTO_TEST_CASE(FileDescriptorError)
+{
+  FileDescriptorSink sink(-1);
+  BOOST_CHECK_THROW(sink.write(content.data(), content.size()), SegmentSink::Error);
+}
+
+BOOST_AUTO_TEST_CASE(MappedFile)
+{
+  {
+    // a one-page window makes the content span several windows
+    MappedFileSink sink(path, 1);
+    writeContent(sink);
+    sink.finish();
+  }
+
+  std::vector<uint8_t> written = readFile();
+  BOOST_CHECK_EQUAL_COLLECTIONS(written.begin(), written.end(), content.begin(), content.end());
+}
+
+BOOST_AUTO_TEST_CASE(MappedFileAllocated)
+{
+  size_t windowSize = 16 * static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+  MappedFileSink sink(path, windowSize);
+  sink.write(content.data(), 1);
+
+  // the window is backed by allocated blocks rather than being a hole in a sparse file
+  struct stat status;
+  BOOST_REQUIRE_EQUAL(::stat(path.c_str(), &status), 0);
+  BOOST_CHECK_GE(static_cast<size_t>(status.st_blocks) * 512, windowSize);
+}
+
+BOOST_AUTO_TEST_CASE(MappedFileNoSpace)
+{
+  // a file size limit of two windows stands for a full disk
+  size_t windowSize = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+  rlimit oldLimit;
+  BOOST_REQUIRE_EQUAL(::getrlimit(RLIMIT_FSIZE, &oldLimit), 0);
+  rlimit limit = oldLimit;
+  limit.rlim_cur = 2 * windowSize;
+  BOOST_REQUIRE_EQUAL(::setrlimit(RLIMIT_FSIZE, &limit), 0);
+  void (*oldHandler)(int) = std::signal(SIGXFSZ, SIG_IGN);
+
+  std::vector<uint8_t> large(3 * windowSize);
+  {
+    MappedFileSink sink(path, windowSize);
+    BOOST_CHECK_THROW(sink.write(large.data(), large.size()), SegmentSink::Error);
+  }
+
+  std::signal(SIGXFSZ, oldHandler);
+  ::setrlimit(RLIMIT_FSIZE, &oldLimit);
+}
+
+BOOST_AUTO_TEST_CASE(MappedFileOpenError)
+{
+  BOOST_CHECK_THROW(MappedFileSink("/nonexistent-directory/file"), SegmentSink::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace util
+} // namespace ndn
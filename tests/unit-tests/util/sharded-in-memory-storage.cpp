@@ -0,0 +1,164 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2014 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "util/sharded-in-memory-storage.hpp"
+#include "util/in-memory-storage-persistent.hpp"
+#include "util/in-memory-storage-lru.hpp"
+
+#include "boost-test.hpp"
+#include "../test-make-interest-data.hpp"
+
+#include <atomic>
+#include <thread>
+
+namespace ndn {
+namespace util {
+namespace tests {
+
+static unique_ptr<InMemoryStorage>
+makePersistent()
+{
+  return unique_ptr<InMemoryStorage>(new InMemoryStoragePersistent());
+}
+
+BOOST_AUTO_TEST_SUITE(UtilShardedInMemoryStorage)
+
+BOOST_AUTO_TEST_CASE(ShardSelection)
+{
+  ShardedInMemoryStorage storage(4, 2, &makePersistent);
+  BOOST_CHECK_EQUAL(storage.getNShards(), 4);
+  BOOST_CHECK_EQUAL(storage.getShardPrefixLength(), 2);
+
+  shared_ptr<Data> data = makeData("/a/b/c");
+  size_t shard = storage.getShardOfData(data->getName());
+  BOOST_CHECK_EQUAL(storage.getShardOfData("/a/b"), shard);
+  BOOST_CHECK_EQUAL(storage.getShardOfPrefix("/a/b"), shard);
+  BOOST_CHECK_EQUAL(storage.getShardOfPrefix("/a/b/c/d"), shard);
+  BOOST_CHECK_EQUAL(storage.getShardOfPrefix("/a"), ShardedInMemoryStorage::ALL_SHARDS);
+  BOOST_CHECK_EQUAL(storage.getShardOfPrefix("/"), ShardedInMemoryStorage::ALL_SHARDS);
+
+  // a full Name locates the shard even if the Data Name is shorter than the shard prefix
+  shared_ptr<Data> shortData = makeData("/a");
+  BOOST_CHECK_EQUAL(storage.getShardOfPrefix(shortData->getFullName()),
+                    storage.getShardOfData("/a"));
+}
+
+BOOST_AUTO_TEST_CASE(SameResultsAsSingleStorage)
+{
+  ShardedInMemoryStorage storage(4, 2, &makePersistent);
+  InMemoryStoragePersistent reference;
+
+  const char* names[] = {"/", "/a", "/a/b", "/a/b/1", "/a/b/2", "/a/c/1", "/a/c/2/x",
+                         "/a/d", "/b/a", "/b/b/b", "/c"};
+  std::vector<shared_ptr<Data>> packets;
+  for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); ++i) {
+    packets.push_back(makeData(names[i]));
+    storage.insert(*packets.back());
+    reference.insert(*packets.back());
+  }
+  BOOST_CHECK_EQUAL(storage.size(), reference.size());
+
+  std::vector<Name> prefixes;
+  for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); ++i) {
+    prefixes.push_back(names[i]);
+  }
+  prefixes.push_back(packets[1]->getFullName());
+  prefixes.push_back("/a/c");
+  prefixes.push_back("/z");
+
+  for (size_t i = 0; i < prefixes.size(); ++i) {
+    for (int childSelector = 0; childSelector <= 1; ++childSelector) {
+      Interest interest(prefixes[i]);
+      interest.setChildSelector(childSelector);
+
+      shared_ptr<const Data> expected = reference.find(interest);
+      shared_ptr<const Data> found = storage.find(interest);
+      BOOST_REQUIRE_EQUAL(static_cast<bool>(found), static_cast<bool>(expected));
+      if (expected != nullptr) {
+        BOOST_CHECK_EQUAL(found->getFullName(), expected->getFullName());
+      }
+    }
+
+    shared_ptr<const Data> expected = reference.find(prefixes[i]);
+    shared_ptr<const Data> found = storage.find(prefixes[i]);
+    BOOST_REQUIRE_EQUAL(static_cast<bool>(found), static_cast<bool>(expected));
+    if (expected != nullptr) {
+      BOOST_CHECK_EQUAL(found->getFullName(), expected->getFullName());
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(EraseAcrossShards)
+{
+  ShardedInMemoryStorage storage(4, 2, &makePersistent);
+
+  shared_ptr<Data> other = makeData("/b");
+  storage.insert(*other);
+  for (int i = 0; i < 20; ++i) {
+    storage.insert(*makeData(Name("/a").appendNumber(i).append("x")));
+  }
+  BOOST_CHECK_EQUAL(storage.size(), 21);
+
+  storage.erase("/a/%01", true);
+  BOOST_CHECK_EQUAL(storage.size(), 20);
+
+  storage.erase("/a", true);
+  BOOST_CHECK_EQUAL(storage.size(), 1);
+  BOOST_CHECK(storage.find(Interest("/a")) == nullptr);
+
+  storage.erase(other->getFullName(), false);
+  BOOST_CHECK_EQUAL(storage.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(AccessFromManyThreads)
+{
+  ShardedInMemoryStorage storage(4, 2, [] {
+      return unique_ptr<InMemoryStorage>(new InMemoryStorageLru(10000));
+    });
+
+  std::atomic<size_t> nMisses(0);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < 8; ++i) {
+    threads.push_back(std::thread([&storage, &nMisses, i] {
+      for (size_t j = 0; j < 200; ++j) {
+        Name name = Name("/thread").appendNumber(i).appendNumber(j);
+        storage.insert(*makeData(name));
+        if (storage.find(Interest(name)) == nullptr)
+          ++nMisses;
+        if (j % 10 == 9) {
+          storage.erase(Name("/thread").appendNumber(i), true);
+        }
+      }
+    }));
+  }
+  for (size_t i = 0; i < threads.size(); ++i) {
+    threads[i].join();
+  }
+
+  BOOST_CHECK_EQUAL(nMisses.load(), 0);
+  BOOST_CHECK_EQUAL(storage.size(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace util
+} // namespace ndn
@@ -0,0 +1,114 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2014 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "util/in-memory-storage-arc.hpp"
+#include "security/key-chain.hpp"
+
+#include "boost-test.hpp"
+#include "../test-make-interest-data.hpp"
+
+namespace ndn {
+namespace util {
+
+BOOST_AUTO_TEST_SUITE(UtilInMemoryStorage)
+BOOST_AUTO_TEST_SUITE(Arc)
+
+BOOST_AUTO_TEST_CASE(ScanResistance)
+{
+  InMemoryStorageArc ims(10);
+
+  for (int i = 0; i < 5; ++i) {
+    Name name("/hot");
+    name.appendNumber(i);
+    ims.insert(*makeData(name));
+    ims.find(*makeInterest(name));
+  }
+
+  // a scan longer than the storage only displaces entries accessed once
+  for (int i = 0; i < 20; ++i) {
+    Name name("/scan");
+    name.appendNumber(i);
+    ims.insert(*makeData(name));
+  }
+  BOOST_CHECK_EQUAL(ims.size(), 10);
+
+  for (int i = 0; i < 5; ++i) {
+    Name name("/hot");
+    name.appendNumber(i);
+    BOOST_CHECK(static_cast<bool>(ims.find(*makeInterest(name))));
+  }
+  BOOST_CHECK(!static_cast<bool>(ims.find(*makeInterest("/scan/%00"))));
+  BOOST_CHECK(static_cast<bool>(ims.find(*makeInterest("/scan/%13"))));
+}
+
+BOOST_AUTO_TEST_CASE(GhostHit)
+{
+  InMemoryStorageArc ims(3);
+
+  shared_ptr<Data> data1 = makeData("/insert/1");
+  ims.insert(*data1);
+  ims.insert(*makeData("/insert/2"));
+  ims.find(*makeInterest("/insert/2"));
+  ims.insert(*makeData("/insert/3"));
+  ims.insert(*makeData("/insert/4"));
+  BOOST_CHECK_EQUAL(ims.size(), 3);
+  BOOST_CHECK(!static_cast<bool>(ims.find(*makeInterest("/insert/1"))));
+  BOOST_CHECK_EQUAL(ims.getRecencyTarget(), 0);
+
+  // the packet comes back shortly after its eviction, so the recency list grows
+  ims.insert(*data1);
+  BOOST_CHECK_EQUAL(ims.getRecencyTarget(), 1);
+  BOOST_CHECK_EQUAL(ims.size(), 3);
+  BOOST_CHECK(!static_cast<bool>(ims.find(*makeInterest("/insert/3"))));
+  BOOST_CHECK(static_cast<bool>(ims.find(*makeInterest("/insert/1"))));
+  BOOST_CHECK(static_cast<bool>(ims.find(*makeInterest("/insert/2"))));
+  BOOST_CHECK(static_cast<bool>(ims.find(*makeInterest("/insert/4"))));
+}
+
+BOOST_AUTO_TEST_CASE(GhostReleasesPacket)
+{
+  InMemoryStorageArc ims(2);
+
+  // decode from a copy, so that the packet does not share its buffer with other packets
+  Block wire = makeData("/insert/1")->wireEncode();
+  shared_ptr<Data> data = make_shared<Data>(Block(wire.wire(), wire.size()));
+  weak_ptr<const Buffer> buffer = data->wireEncode().getBuffer();
+  ims.insert(*data);
+  data.reset();
+
+  ims.insert(*makeData("/insert/2"));
+  ims.find(*makeInterest("/insert/2"));
+
+  // /insert/1 is evicted from the recency list and remembered in its ghost list
+  ims.insert(*makeData("/insert/3"));
+  BOOST_CHECK(!static_cast<bool>(ims.find(*makeInterest("/insert/1"))));
+  BOOST_CHECK(buffer.expired());
+
+  // the ghost is still recognized
+  ims.insert(*make_shared<Data>(wire));
+  BOOST_CHECK_EQUAL(ims.getRecencyTarget(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // Arc
+BOOST_AUTO_TEST_SUITE_END() // UtilInMemoryStorage
+
+} // namespace util
+} // namespace ndn
@@ -23,10 +23,13 @@
 #include "util/in-memory-storage-fifo.hpp"
 #include "util/in-memory-storage-lfu.hpp"
 #include "util/in-memory-storage-lru.hpp"
+#include "util/in-memory-storage-arc.hpp"
+#include "util/in-memory-storage-tinylfu.hpp"
 #include "security/key-chain.hpp"
 
 #include "boost-test.hpp"
 #include "../test-make-interest-data.hpp"
+#include "../unit-test-time-fixture.hpp"
 
 #include <boost/mpl/list.hpp>
 
@@ -38,7 +41,8 @@ BOOST_AUTO_TEST_SUITE(UtilInMemoryStorage)
 BOOST_AUTO_TEST_SUITE(Common)
 
 typedef boost::mpl::list<InMemoryStoragePersistent, InMemoryStorageFifo, InMemoryStorageLfu,
-                         InMemoryStorageLru> InMemoryStorages;
+                         InMemoryStorageLru, InMemoryStorageArc,
+                         InMemoryStorageTinyLfu> InMemoryStorages;
 
 BOOST_AUTO_TEST_CASE_TEMPLATE(Insertion, T, InMemoryStorages)
 {
@@ -111,6 +115,34 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(DuplicateInsertion2, T, InMemoryStorages)
   BOOST_CHECK_EQUAL(ims.size(), 2);
 }
 
+/** @brief Returns a copy of @p data whose wire encoding has a buffer of its own size
+ */
+static shared_ptr<Data>
+makeCompact(const shared_ptr<Data>& data)
+{
+  const Block& wire = data->wireEncode();
+  return make_shared<Data>(Block(wire.wire(), wire.size()));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(FailedInsertion, T, InMemoryStorages)
+{
+  T ims;
+
+  shared_ptr<Data> data = makeData("/insert/smth");
+  ims.insert(*data);
+  size_t nBytes = ims.getNBytes();
+
+  // not managed by shared_ptr, and stored without a copy
+  Data unmanaged(*makeCompact(makeData("/insert/unmanaged")));
+  BOOST_CHECK_THROW(ims.insert(unmanaged), std::bad_weak_ptr);
+  BOOST_CHECK_EQUAL(ims.size(), 1);
+  BOOST_CHECK_EQUAL(ims.getNBytes(), nBytes);
+
+  shared_ptr<Data> data2 = makeData("/insert/original");
+  ims.insert(*data2);
+  BOOST_CHECK_EQUAL(ims.size(), 2);
+}
+
 BOOST_AUTO_TEST_CASE_TEMPLATE(InsertAndFind, T, InMemoryStorages)
 {
   T ims;
@@ -629,8 +661,65 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(ExcludeSelector, T, InMemoryStorages)
   BOOST_CHECK_EQUAL(found3->getName(), "/c/a");
 }
 
-typedef boost::mpl::list<InMemoryStorageFifo, InMemoryStorageLfu, InMemoryStorageLru>
-                         InMemoryStoragesLimited;
+BOOST_AUTO_TEST_CASE_TEMPLATE(ExactNameMatch, T, InMemoryStorages)
+{
+  T ims;
+
+  ims.insert(*makeData("/a/b"));
+  ims.insert(*makeData("/a/b/1"));
+
+  uint32_t content1 = 1;
+  shared_ptr<Data> data1 = makeData("/a");
+  data1->setContent(reinterpret_cast<const uint8_t*>(&content1), sizeof(content1));
+  signData(data1);
+  ims.insert(*data1);
+
+  uint32_t content2 = 2;
+  shared_ptr<Data> data2 = makeData("/a");
+  data2->setContent(reinterpret_cast<const uint8_t*>(&content2), sizeof(content2));
+  signData(data2);
+  ims.insert(*data2);
+
+  const Name& leftmost = std::min(data1->getFullName(), data2->getFullName());
+
+  // served by the hashed index
+  shared_ptr<Interest> interest = makeInterest("/a");
+  shared_ptr<const Data> found = ims.find(*interest);
+  BOOST_REQUIRE(static_cast<bool>(found));
+  BOOST_CHECK_EQUAL(found->getFullName(), leftmost);
+
+  // the Exclude filter forces the ordered lookup, which must agree
+  shared_ptr<Interest> interest2 = makeInterest("/a");
+  Exclude e;
+  e.excludeOne(Name::Component("z"));
+  interest2->setExclude(e);
+  shared_ptr<const Data> found2 = ims.find(*interest2);
+  BOOST_REQUIRE(static_cast<bool>(found2));
+  BOOST_CHECK_EQUAL(found2->getFullName(), leftmost);
+
+  // selectors that need children still take the ordered lookup
+  shared_ptr<Interest> interest3 = makeInterest("/a");
+  interest3->setMinSuffixComponents(2);
+  shared_ptr<const Data> found3 = ims.find(*interest3);
+  BOOST_REQUIRE(static_cast<bool>(found3));
+  BOOST_CHECK_EQUAL(found3->getName(), "/a/b");
+
+  // without an exact match, the lookup falls back to the ordered index
+  ims.erase(data1->getFullName(), false);
+  ims.erase(data2->getFullName(), false);
+  BOOST_CHECK_EQUAL(ims.size(), 2);
+
+  shared_ptr<const Data> found4 = ims.find(*interest);
+  BOOST_REQUIRE(static_cast<bool>(found4));
+  BOOST_CHECK_EQUAL(found4->getName(), "/a/b");
+
+  shared_ptr<const Data> found5 = ims.find(*makeInterest("/a/b/1"));
+  BOOST_REQUIRE(static_cast<bool>(found5));
+  BOOST_CHECK_EQUAL(found5->getName(), "/a/b/1");
+}
+
+typedef boost::mpl::list<InMemoryStorageFifo, InMemoryStorageLfu, InMemoryStorageLru,
+                         InMemoryStorageArc, InMemoryStorageTinyLfu> InMemoryStoragesLimited;
 
 BOOST_AUTO_TEST_CASE_TEMPLATE(setCapacity, T, InMemoryStoragesLimited)
 {
@@ -676,7 +765,11 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(InsertAndDouble, T, InMemoryStoragesLimited)
   BOOST_CHECK_EQUAL(ims.getCapacity(), 20);
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(InsertAndEvict, T, InMemoryStoragesLimited)
+// W-TinyLFU keeps the older entry when the access frequencies tie
+typedef boost::mpl::list<InMemoryStorageFifo, InMemoryStorageLfu, InMemoryStorageLru,
+                         InMemoryStorageArc> InMemoryStoragesEvictingOldest;
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(InsertAndEvict, T, InMemoryStoragesEvictingOldest)
 {
   T ims(2);
 
@@ -699,6 +792,169 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(InsertAndEvict, T, InMemoryStoragesLimited)
   BOOST_CHECK(!static_cast<bool>(found));
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE(ByteLimit, T, InMemoryStoragesLimited)
+{
+  T ims(100);
+  BOOST_CHECK_EQUAL(ims.getByteLimit(), std::numeric_limits<size_t>::max());
+  BOOST_CHECK_EQUAL(ims.getNBytes(), 0);
+
+  shared_ptr<Data> data1 = makeData("/1");
+  shared_ptr<Data> data2 = makeData("/2");
+  shared_ptr<Data> data3 = makeData("/3");
+  size_t entrySize = data1->wireEncode().size() + InMemoryStorage::ENTRY_OVERHEAD;
+
+  ims.setByteLimit(2 * entrySize);
+  ims.insert(*data1);
+  ims.insert(*data2);
+  BOOST_CHECK_EQUAL(ims.size(), 2);
+  BOOST_CHECK_EQUAL(ims.getNBytes(), 2 * entrySize);
+
+  ims.insert(*data3);
+  BOOST_CHECK_EQUAL(ims.size(), 2);
+  BOOST_CHECK_EQUAL(ims.getNBytes(), 2 * entrySize);
+  BOOST_CHECK(static_cast<bool>(ims.find(Name("/3"))));
+
+  ims.setByteLimit(entrySize);
+  BOOST_CHECK_EQUAL(ims.size(), 1);
+  BOOST_CHECK_EQUAL(ims.getNBytes(), entrySize);
+
+  ims.erase("/");
+  BOOST_CHECK_EQUAL(ims.size(), 0);
+  BOOST_CHECK_EQUAL(ims.getNBytes(), 0);
+
+  // a packet larger than the whole budget is not inserted
+  shared_ptr<Data> large = makeData("/large");
+  std::vector<uint8_t> content(100);
+  large->setContent(&content.front(), content.size());
+  signData(large);
+  ims.insert(*data1);
+  ims.insert(*large);
+  BOOST_CHECK_EQUAL(ims.size(), 1);
+  BOOST_CHECK(!static_cast<bool>(ims.find(Name("/large"))));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(ByteLimitCompactsBuffer, T, InMemoryStorages)
+{
+  T ims;
+
+  // the packet is decoded from a buffer that is much larger than its wire encoding
+  Block wire = makeData("/1")->wireEncode();
+  shared_ptr<Buffer> buffer = make_shared<Buffer>(wire.size() + 4096);
+  std::copy(wire.begin(), wire.end(), buffer->begin());
+  shared_ptr<Data> data = make_shared<Data>(Block(buffer, buffer->begin(),
+                                                  buffer->begin() + wire.size()));
+  Name fullName = Data(wire).getFullName();
+  weak_ptr<Buffer> weakBuffer = buffer;
+  buffer.reset();
+
+  ims.insert(*data);
+  BOOST_CHECK_EQUAL(ims.getNBytes(), wire.size() + InMemoryStorage::ENTRY_OVERHEAD);
+
+  // the storage keeps a compact copy, not the large buffer
+  data.reset();
+  BOOST_CHECK(weakBuffer.expired());
+  shared_ptr<const Data> found = ims.find(fullName);
+  BOOST_REQUIRE(static_cast<bool>(found));
+  BOOST_CHECK_EQUAL(found->getFullName(), fullName);
+  BOOST_CHECK(found->wireEncode() == wire);
+
+  ims.erase("/1");
+  BOOST_CHECK_EQUAL(ims.getNBytes(), 0);
+}
+
+BOOST_FIXTURE_TEST_SUITE(Freshness, tests::UnitTestTimeFixture)
+
+static shared_ptr<Data>
+makeFreshData(const Name& name, const time::milliseconds& freshnessPeriod)
+{
+  shared_ptr<Data> data = makeData(name);
+  data->setFreshnessPeriod(freshnessPeriod);
+  return signData(data);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(MustBeFresh, T, InMemoryStorages)
+{
+  T ims;
+  ims.insert(*makeFreshData("/A/1", time::seconds(1)));
+  ims.insert(*makeData("/B/1")); // without FreshnessPeriod
+
+  shared_ptr<Interest> interestA = makeInterest("/A");
+  interestA->setMustBeFresh(true);
+  shared_ptr<Interest> interestB = makeInterest("/B");
+  interestB->setMustBeFresh(true);
+
+  BOOST_CHECK(static_cast<bool>(ims.find(*interestA)));
+
+  advanceClocks(time::milliseconds(1500));
+  BOOST_CHECK(!static_cast<bool>(ims.find(*interestA)));
+  BOOST_CHECK(static_cast<bool>(ims.find(*interestB)));
+
+  interestA->setMustBeFresh(false);
+  BOOST_CHECK(static_cast<bool>(ims.find(*interestA)));
+
+  // inserting the packet again restarts its freshness period
+  interestA->setMustBeFresh(true);
+  ims.insert(*makeFreshData("/A/1", time::seconds(1)));
+  BOOST_CHECK(static_cast<bool>(ims.find(*interestA)));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(MustBeFreshSkipsStale, T, InMemoryStorages)
+{
+  T ims;
+  ims.insert(*makeFreshData("/A/1", time::seconds(1)));
+  ims.insert(*makeFreshData("/A/2", time::seconds(10)));
+
+  advanceClocks(time::milliseconds(1500));
+
+  shared_ptr<Interest> interest = makeInterest("/A");
+  interest->setMustBeFresh(true);
+  shared_ptr<const Data> found = ims.find(*interest);
+  BOOST_REQUIRE(static_cast<bool>(found));
+  BOOST_CHECK_EQUAL(found->getName(), "/A/2");
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(EraseStale, T, InMemoryStorages)
+{
+  T ims;
+  ims.insert(*makeFreshData("/A", time::seconds(1)));
+  ims.insert(*makeFreshData("/B", time::seconds(2)));
+  ims.insert(*makeFreshData("/C", time::seconds(3)));
+  ims.insert(*makeData("/D"));
+
+  advanceClocks(time::milliseconds(2500));
+  BOOST_CHECK_EQUAL(ims.eraseStale(), 2);
+  BOOST_CHECK_EQUAL(ims.size(), 2);
+  BOOST_CHECK(!static_cast<bool>(ims.find(Name("/A"))));
+  BOOST_CHECK(static_cast<bool>(ims.find(Name("/C"))));
+
+  advanceClocks(time::seconds(3600));
+  BOOST_CHECK_EQUAL(ims.eraseStale(), 1);
+  BOOST_CHECK(static_cast<bool>(ims.find(Name("/D"))));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(StaleFirstEviction, T, InMemoryStoragesLimited)
+{
+  T ims(3);
+  BOOST_CHECK_EQUAL(ims.getStaleFirstEviction(), false);
+  ims.setStaleFirstEviction(true);
+
+  ims.insert(*makeFreshData("/1", time::seconds(10)));
+  ims.insert(*makeFreshData("/2", time::seconds(1)));
+  ims.insert(*makeFreshData("/3", time::seconds(10)));
+
+  advanceClocks(time::milliseconds(1500));
+  ims.insert(*makeFreshData("/4", time::seconds(10)));
+  BOOST_CHECK_EQUAL(ims.size(), 3);
+  BOOST_CHECK(!static_cast<bool>(ims.find(Name("/2"))));
+  BOOST_CHECK(static_cast<bool>(ims.find(Name("/1"))));
+
+  // without stale entries, the replacement policy applies
+  ims.insert(*makeFreshData("/5", time::seconds(10)));
+  BOOST_CHECK_EQUAL(ims.size(), 3);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // Freshness
+
 ///as Find function is implemented at the base case, therefore testing for one derived class is
 ///sufficient for all
 class FindFixture
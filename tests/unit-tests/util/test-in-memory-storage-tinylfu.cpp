@@ -0,0 +1,113 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2014 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "util/in-memory-storage-tinylfu.hpp"
+#include "security/key-chain.hpp"
+
+#include "boost-test.hpp"
+#include "../test-make-interest-data.hpp"
+
+namespace ndn {
+namespace util {
+
+BOOST_AUTO_TEST_SUITE(UtilInMemoryStorage)
+BOOST_AUTO_TEST_SUITE(TinyLfu)
+
+BOOST_AUTO_TEST_CASE(Frequency)
+{
+  InMemoryStorageTinyLfu ims;
+
+  shared_ptr<Data> data = makeData("/insert/1");
+  BOOST_CHECK_EQUAL(ims.getFrequency(data->getFullName()), 0);
+
+  ims.insert(*data);
+  BOOST_CHECK_EQUAL(ims.getFrequency(data->getFullName()), 1);
+
+  shared_ptr<Interest> interest = makeInterest("/insert/1");
+  ims.find(*interest);
+  ims.find(*interest);
+  BOOST_CHECK_EQUAL(ims.getFrequency(data->getFullName()), 3);
+
+  // 4-bit counters saturate without touching the counters packed next to them
+  for (int i = 0; i < 20; ++i) {
+    ims.find(*interest);
+  }
+  BOOST_CHECK_EQUAL(ims.getFrequency(data->getFullName()), 15);
+  BOOST_CHECK_EQUAL(ims.getFrequency(makeData("/insert/2")->getFullName()), 0);
+}
+
+BOOST_AUTO_TEST_CASE(ScanResistance)
+{
+  InMemoryStorageTinyLfu ims(10);
+
+  for (int i = 0; i < 5; ++i) {
+    Name name("/hot");
+    name.appendNumber(i);
+    ims.insert(*makeData(name));
+    for (int j = 0; j < 5; ++j) {
+      ims.find(*makeInterest(name));
+    }
+  }
+
+  // entries seen once lose the admission contest against frequently accessed ones
+  for (int i = 0; i < 20; ++i) {
+    Name name("/scan");
+    name.appendNumber(i);
+    ims.insert(*makeData(name));
+  }
+  BOOST_CHECK_EQUAL(ims.size(), 10);
+
+  for (int i = 0; i < 5; ++i) {
+    Name name("/hot");
+    name.appendNumber(i);
+    BOOST_CHECK(static_cast<bool>(ims.find(*makeInterest(name))));
+  }
+  // the most recent packet is always admitted to the window
+  BOOST_CHECK(static_cast<bool>(ims.find(*makeInterest("/scan/%13"))));
+}
+
+BOOST_AUTO_TEST_CASE(Promotion)
+{
+  InMemoryStorageTinyLfu ims(3);
+
+  ims.insert(*makeData("/insert/1"));
+  ims.insert(*makeData("/insert/2"));
+  ims.insert(*makeData("/insert/3"));
+
+  // /insert/1 and /insert/2 enter the main segment, and on a frequency tie the window
+  // candidate /insert/3 is evicted
+  ims.insert(*makeData("/insert/4"));
+  BOOST_CHECK(!static_cast<bool>(ims.find(Name("/insert/3"))));
+
+  // /insert/1 gets protected
+  ims.find(*makeInterest("/insert/1"));
+  ims.find(*makeInterest("/insert/1"));
+
+  ims.evictItem();
+  BOOST_CHECK_EQUAL(ims.size(), 2);
+  BOOST_CHECK(static_cast<bool>(ims.find(*makeInterest("/insert/1"))));
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TinyLfu
+BOOST_AUTO_TEST_SUITE_END() // UtilInMemoryStorage
+
+} // namespace util
+} // namespace ndn
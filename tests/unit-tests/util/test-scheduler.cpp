@@ -201,6 +201,105 @@ BOOST_FIXTURE_TEST_CASE(CancelAll, CancelAllFixture)
 }
 
 
+BOOST_AUTO_TEST_CASE(TimingWheelEvents)
+{
+  size_t count1 = 0;
+  size_t count2 = 0;
+
+  Scheduler scheduler(io, Scheduler::QUEUE_TIMING_WHEEL);
+  scheduler.scheduleEvent(time::milliseconds(500), [&] {
+      ++count1;
+      BOOST_CHECK_EQUAL(count2, 1);
+    });
+
+  EventId i = scheduler.scheduleEvent(time::seconds(1), [&] {
+      BOOST_ERROR("This event should not have been fired");
+    });
+  scheduler.cancelEvent(i);
+
+  scheduler.scheduleEvent(time::milliseconds(250), [&] {
+      BOOST_CHECK_EQUAL(count1, 0);
+      ++count2;
+    });
+
+  i = scheduler.scheduleEvent(time::milliseconds(50), [&] {
+      BOOST_ERROR("This event should not have been fired");
+    });
+  scheduler.cancelEvent(i);
+
+  advanceClocks(time::milliseconds(1), 1000);
+  BOOST_CHECK_EQUAL(count1, 1);
+  BOOST_CHECK_EQUAL(count2, 1);
+}
+
+BOOST_AUTO_TEST_CASE(TimingWheelLongDelays)
+{
+  Scheduler scheduler(io, Scheduler::QUEUE_TIMING_WHEEL);
+  time::steady_clock::TimePoint start = time::steady_clock::now();
+
+  std::vector<time::nanoseconds> delays;
+  delays.push_back(time::hours(50 * 24)); // beyond the top level of the wheel
+  delays.push_back(time::hours(5));
+  delays.push_back(time::milliseconds(300));
+  delays.push_back(time::seconds(70));
+  delays.push_back(time::microseconds(1500));
+
+  std::vector<time::nanoseconds> fired;
+  for (size_t i = 0; i < delays.size(); ++i) {
+    time::nanoseconds delay = delays[i];
+    scheduler.scheduleEvent(delay, [&, delay] {
+        BOOST_CHECK(time::steady_clock::now() - start >= delay);
+        fired.push_back(delay);
+      });
+  }
+
+  advanceClocks(time::microseconds(500), 10);
+  advanceClocks(time::milliseconds(1), 1000);
+  advanceClocks(time::milliseconds(100), 1000);
+  advanceClocks(time::minutes(1), 300);
+  BOOST_REQUIRE_EQUAL(fired.size(), 4);
+  BOOST_CHECK(fired[0] == time::microseconds(1500));
+  BOOST_CHECK(fired[1] == time::milliseconds(300));
+  BOOST_CHECK(fired[2] == time::seconds(70));
+  BOOST_CHECK(fired[3] == time::hours(5));
+
+  advanceClocks(time::hours(1), 50 * 24);
+  advanceClocks(time::milliseconds(1), 2);
+  BOOST_CHECK_EQUAL(fired.size(), 5);
+}
+
+BOOST_AUTO_TEST_CASE(TimingWheelCancelAll)
+{
+  Scheduler scheduler(io, Scheduler::QUEUE_TIMING_WHEEL);
+
+  size_t count = 0;
+  scheduler.scheduleEvent(time::milliseconds(300), [&] { ++count; });
+  scheduler.scheduleEvent(time::milliseconds(500), [&] { scheduler.cancelAllEvents(); });
+  scheduler.scheduleEvent(time::milliseconds(700), [&] { ++count; });
+
+  EventId i = scheduler.scheduleEvent(time::seconds(3), [] {
+      BOOST_ERROR("This event should have been cancelled");
+    });
+
+  advanceClocks(time::milliseconds(100), 100);
+  scheduler.cancelEvent(i);
+
+  BOOST_CHECK_EQUAL(count, 1);
+}
+
+BOOST_AUTO_TEST_CASE(TimingWheelEventIdOutlivesScheduler)
+{
+  EventId i;
+  {
+    Scheduler scheduler(io, Scheduler::QUEUE_TIMING_WHEEL);
+    for (int n = 0; n < 1000; ++n)
+      i = scheduler.scheduleEvent(time::seconds(1), [] {});
+  }
+  BOOST_CHECK(static_cast<bool>(i));
+  i.reset();
+}
+
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace tests
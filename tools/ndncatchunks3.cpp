@@ -22,6 +22,7 @@
  */
 
 #include "face.hpp"
+#include "name-builder.hpp"
 
 namespace ndn {
 
@@ -31,7 +32,7 @@ public:
   Consumer(const std::string& dataName,
            size_t pipeSize, size_t nTotalSegments,
            int scope = -1, bool mustBeFresh = true)
-    : m_dataName(dataName)
+    : m_dataName(Name(dataName))
     , m_pipeSize(pipeSize)
     , m_nTotalSegments(nTotalSegments)
     , m_nextSegment(0)
@@ -59,7 +60,7 @@ private:
   onTimeout(const Interest& interest);
 
   Face m_face;
-  Name m_dataName;
+  NameBuilder m_dataName;
   size_t m_pipeSize;
   size_t m_nTotalSegments;
   size_t m_nextSegment;
@@ -77,7 +78,7 @@ Consumer::run()
     {
       for (size_t i = 0; i < m_pipeSize; i++)
         {
-          Interest interest(Name(m_dataName).appendSegment(m_nextSegment++));
+          Interest interest(m_dataName.appendSegment(m_nextSegment++));
           interest.setInterestLifetime(time::milliseconds(4000));
           if (m_scope >= 0)
             interest.setScope(m_scope);
@@ -118,7 +119,7 @@ Consumer::onData(Data& data)
   else
     {
       // Send interest for next segment
-      Interest interest(Name(m_dataName).appendSegment(m_nextSegment++));
+      Interest interest(m_dataName.appendSegment(m_nextSegment++));
       if (m_scope >= 0)
         interest.setScope(m_scope);
       interest.setInterestLifetime(time::milliseconds(4000));
@@ -22,6 +22,7 @@
  */
 
 #include "face.hpp"
+#include "name-builder.hpp"
 #include "security/key-chain.hpp"
 
 namespace ndn {
@@ -35,20 +36,24 @@ public:
     : m_name(name)
     , m_isVerbose(false)
   {
+    NameBuilder segmentNames(m_name);
     int segnum = 0;
-    char* buf = new char[MAX_SEG_SIZE];
     do
       {
-        std::cin.read(buf, MAX_SEG_SIZE);
+        shared_ptr<Data> data =
+          make_shared<Data>(segmentNames.appendSegment(segnum));
+
+        // read straight into the packet, so that signing does not copy the content
+        uint8_t* content = data->allocateContent(MAX_SEG_SIZE);
+        std::cin.read(reinterpret_cast<char*>(content), MAX_SEG_SIZE);
         int got = std::cin.gcount();
 
         if (got > 0)
           {
-            shared_ptr<Data> data =
-              make_shared<Data>(Name(m_name).appendSegment(segnum));
+            if (static_cast<size_t>(got) < MAX_SEG_SIZE)
+              data->setContent(content, got);
 
             data->setFreshnessPeriod(time::milliseconds(10000)); // 10 sec
-            data->setContent(reinterpret_cast<const uint8_t*>(buf), got);
 
             m_keychain.sign(*data);
             m_store.push_back(data);